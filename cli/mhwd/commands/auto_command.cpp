@@ -0,0 +1,60 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "auto_command.hpp"
+#include "common/output.hpp"
+
+#include <mhwd/Transaction.hpp>
+
+#include <coro/sync_wait.hpp>
+
+#include <fmt/color.h>
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+
+namespace mcp::cli::mhwd {
+
+using mcp::cli::out;
+
+int AutoCommand::execute()
+{
+    out().set_color_enabled(color_enabled_);
+
+    auto selection = coro::sync_wait(provider_.select_best(type_, drivers_, class_id_));
+    if (!selection) {
+        out().error("Failed to load configurations");
+        return 1;
+    }
+
+    if (selection->install.empty()) {
+        out().info("No new drivers to install");
+        return 0;
+    }
+
+    out().header("Selected drivers");
+    for (const auto& config : selection->selected) {
+        fmt::print("  {} {} (priority {}, {})\n",
+                   fmt::styled(config.name(), fmt::emphasis::bold),
+                   config.version(),
+                   config.priority(),
+                   config.is_free_driver() ? "free" : "nonfree");
+    }
+
+    // Built from the selection printed above, not a second match
+    auto command = mcp::mhwd::build_auto_install(*selection);
+    if (!command) {
+        out().error("Failed to build transaction");
+        return 1;
+    }
+
+    out().println();
+    out().info(fmt::format("Install order: {}", fmt::join(command->packages, ", ")));
+
+    return 0;
+}
+
+} // namespace mcp::cli::mhwd
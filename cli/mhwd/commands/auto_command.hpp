@@ -0,0 +1,47 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <mhwd/ConfigProvider.hpp>
+
+#include <optional>
+
+namespace mcp::cli::mhwd {
+
+/**
+ * Show the best driver configurations for detected hardware and the
+ * order they would be installed in, like "mhwd -a" without installing.
+ */
+class AutoCommand {
+public:
+    AutoCommand(
+        mcp::mhwd::ConfigProvider& provider,
+        mcp::mhwd::BusType type,
+        mcp::mhwd::DriverSelection drivers,
+        std::optional<mcp::mhwd::HardwareId> class_id,
+        bool color_enabled
+    )
+        : provider_(provider)
+        , type_(type)
+        , drivers_(drivers)
+        , class_id_(class_id)
+        , color_enabled_(color_enabled)
+    {
+    }
+
+    int execute();
+
+private:
+    mcp::mhwd::ConfigProvider& provider_;
+    mcp::mhwd::BusType type_;
+    mcp::mhwd::DriverSelection drivers_;
+    std::optional<mcp::mhwd::HardwareId> class_id_;
+    bool color_enabled_;
+};
+
+} // namespace mcp::cli::mhwd
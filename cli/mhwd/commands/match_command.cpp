@@ -0,0 +1,89 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "match_command.hpp"
+#include "common/output.hpp"
+
+#include <fmt/color.h>
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+
+#include <chrono>
+#include <ranges>
+
+namespace mcp::cli::mhwd {
+
+using mcp::cli::out;
+
+int MatchCommand::execute()
+{
+    out().set_color_enabled(color_enabled_);
+
+    const auto snapshots = mcp::mhwd::BatchMatcher::find_snapshots(snapshots_dir_);
+    if (snapshots.empty()) {
+        out().error(fmt::format("No snapshots found in '{}'", snapshots_dir_.string()));
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    mcp::mhwd::BatchMatcher matcher(provider_);
+    const auto report = matcher.match_snapshots(snapshots, jobs_);
+
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (!summary_only_) {
+        print_machines(report);
+        out().println();
+    }
+    print_histogram(report);
+
+    out().println();
+    out().info(fmt::format("Matched {} snapshots in {:.1f} ms", snapshots.size(), elapsed.count()));
+    if (report.failed > 0) {
+        out().warning(fmt::format("{} snapshots could not be loaded", report.failed));
+    }
+
+    return report.failed == report.machines.size() ? 1 : 0;
+}
+
+void MatchCommand::print_machines(const mcp::mhwd::BatchReport& report)
+{
+    out().header("Machines");
+
+    for (const auto& machine : report.machines) {
+        const auto name = machine.snapshot.filename().string();
+
+        if (!machine.configs) {
+            fmt::print("  {}: {}\n", name, fmt::styled("unreadable snapshot", fmt::fg(fmt::color::red)));
+            continue;
+        }
+
+        auto names = *machine.configs | std::views::transform(&mcp::mhwd::Config::name);
+        fmt::print("  {} ({} devices): {}\n",
+                   fmt::styled(name, fmt::emphasis::bold),
+                   machine.device_count,
+                   machine.configs->empty() ? "-" : fmt::format("{}", fmt::join(names, ", ")));
+    }
+}
+
+void MatchCommand::print_histogram(const mcp::mhwd::BatchReport& report)
+{
+    out().header("Configs");
+
+    const auto loaded = report.machines.size() - report.failed;
+
+    for (const auto& [config, machines] : report.histogram) {
+        fmt::print("  {:>7} {:>6.1f}%  {:<11} {}\n",
+                   machines,
+                   loaded > 0 ? 100.0 * static_cast<double>(machines) / static_cast<double>(loaded) : 0.0,
+                   mcp::mhwd::to_string(config->bus_type()),
+                   fmt::styled(config->name(), fmt::emphasis::bold));
+    }
+}
+
+} // namespace mcp::cli::mhwd
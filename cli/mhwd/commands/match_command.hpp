@@ -0,0 +1,50 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <mhwd/BatchMatcher.hpp>
+#include <mhwd/ConfigProvider.hpp>
+
+#include <filesystem>
+
+namespace mcp::cli::mhwd {
+
+/**
+ * Match a directory of device snapshots against the config database.
+ */
+class MatchCommand {
+public:
+    MatchCommand(
+        mcp::mhwd::ConfigProvider& provider,
+        std::filesystem::path snapshots_dir,
+        std::size_t jobs,
+        bool summary_only,
+        bool color_enabled
+    )
+        : provider_(provider)
+        , snapshots_dir_(std::move(snapshots_dir))
+        , jobs_(jobs)
+        , summary_only_(summary_only)
+        , color_enabled_(color_enabled)
+    {
+    }
+
+    int execute();
+
+private:
+    mcp::mhwd::ConfigProvider& provider_;
+    std::filesystem::path snapshots_dir_;
+    std::size_t jobs_;
+    bool summary_only_;
+    bool color_enabled_;
+
+    void print_machines(const mcp::mhwd::BatchReport& report);
+    void print_histogram(const mcp::mhwd::BatchReport& report);
+};
+
+} // namespace mcp::cli::mhwd
@@ -0,0 +1,128 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "scan_command.hpp"
+#include "common/output.hpp"
+
+#include <mhwd/DeviceSnapshot.hpp>
+
+#include <coro/sync_wait.hpp>
+
+#include <fmt/color.h>
+#include <fmt/core.h>
+
+#include <chrono>
+#include <vector>
+
+namespace mcp::cli::mhwd {
+
+using mcp::cli::out;
+
+namespace {
+
+std::string_view backend_name(mcp::mhwd::ScanBackend backend)
+{
+    return backend == mcp::mhwd::ScanBackend::Sysfs ? "sysfs" : "udev";
+}
+
+// Mean wall time of one DeviceProvider::scan() over repeat runs
+std::chrono::duration<double, std::milli>
+time_scan(const mcp::mhwd::ScanOptions& options, int repeat, std::size_t& device_count)
+{
+    mcp::mhwd::DeviceProvider provider(options);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; ++i) {
+        coro::sync_wait(provider.scan());
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    device_count = provider.all_devices().size();
+    return std::chrono::duration<double, std::milli>(elapsed) / repeat;
+}
+
+} // namespace
+
+int ScanCommand::execute()
+{
+    out().set_color_enabled(color_enabled_);
+
+    if (repeat_ > 0) {
+        print_timings();
+        return 0;
+    }
+
+    mcp::mhwd::DeviceProvider provider(options_);
+    coro::sync_wait(provider.scan());
+
+    if (!export_path_.empty()) {
+        const auto devices = provider.all_devices();
+
+        if (export_path_ == "-") {
+            fmt::print("{}", mcp::mhwd::to_snapshot(devices));
+            return 0;
+        }
+
+        if (!mcp::mhwd::save_snapshot(export_path_, devices)) {
+            out().error(fmt::format("Failed to write snapshot to '{}'", export_path_));
+            return 1;
+        }
+
+        out().success(fmt::format("Wrote {} devices to '{}'", devices.size(), export_path_));
+        return 0;
+    }
+
+    out().header(fmt::format("Devices ({} backend)", backend_name(options_.backend)));
+    print_devices(provider.all_devices());
+
+    return 0;
+}
+
+void ScanCommand::print_devices(const mcp::mhwd::DeviceVector& devices)
+{
+    for (const auto& device : devices) {
+        fmt::print("  {:<11} {:<14} {}:{}:{}  {:<12} {}\n",
+                   mcp::mhwd::to_string(device.bus_type()),
+                   device.bus_id(),
+                   mcp::mhwd::to_hex_string(device.class_id()),
+                   mcp::mhwd::to_hex_string(device.vendor_id()),
+                   mcp::mhwd::to_hex_string(device.device_id()),
+                   device.driver().empty() ? "-" : device.driver(),
+                   fmt::styled(device.device_name(), fmt::emphasis::bold));
+    }
+}
+
+void ScanCommand::print_timings()
+{
+    out().header(fmt::format("Scan timings ({} runs)", repeat_));
+
+    // libudev always reads the live /sys, comparing it against another tree would be meaningless
+    const bool live = options_.sysfs_root == "/sys";
+
+    std::vector<mcp::mhwd::ScanBackend> backends{mcp::mhwd::ScanBackend::Sysfs};
+    if (live) {
+        backends.insert(backends.begin(), mcp::mhwd::ScanBackend::Udev);
+    }
+
+    for (auto backend : backends) {
+        auto options = options_;
+        options.backend = backend;
+
+        std::size_t device_count = 0;
+        const auto mean = time_scan(options, repeat_, device_count);
+
+        fmt::print("  {:<6} {:>9.3f} ms  ({} devices)\n", backend_name(backend), mean.count(), device_count);
+    }
+
+    if (!live) {
+        out().info(fmt::format("Timed the sysfs backend only, reading {}; "
+                               "mcp-mhwd-scan-bench compares both backends over a fixture",
+                               options_.sysfs_root.string()));
+    }
+}
+
+} // namespace mcp::cli::mhwd
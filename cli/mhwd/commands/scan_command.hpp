@@ -0,0 +1,47 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <mhwd/DeviceProvider.hpp>
+
+#include <string>
+
+namespace mcp::cli::mhwd {
+
+/**
+ * Scan hardware with a selectable backend, optionally timing repeated scans
+ * or exporting a device snapshot.
+ */
+class ScanCommand {
+public:
+    ScanCommand(
+        mcp::mhwd::ScanOptions options,
+        int repeat,
+        std::string export_path,
+        bool color_enabled
+    )
+        : options_(std::move(options))
+        , repeat_(repeat)
+        , export_path_(std::move(export_path))
+        , color_enabled_(color_enabled)
+    {
+    }
+
+    int execute();
+
+private:
+    mcp::mhwd::ScanOptions options_;
+    int repeat_;
+    std::string export_path_;
+    bool color_enabled_;
+
+    void print_devices(const mcp::mhwd::DeviceVector& devices);
+    void print_timings();
+};
+
+} // namespace mcp::cli::mhwd
@@ -13,15 +13,22 @@
 #include "commands/list_command.hpp"
 #include "commands/install_command.hpp"
 #include "commands/remove_command.hpp"
+#include "commands/auto_command.hpp"
+#include "commands/scan_command.hpp"
+#include "commands/match_command.hpp"
 
 #include <mhwd/DeviceProvider.hpp>
 #include <mhwd/ConfigProvider.hpp>
+#include <mhwd/DeviceSnapshot.hpp>
 
 #include <coro/sync_wait.hpp>
 
 #include <CLI/CLI.hpp>
 #include <fmt/core.h>
 
+#include <charconv>
+#include <memory>
+#include <optional>
 #include <string>
 
 int main(int argc, char** argv) {
@@ -34,6 +41,10 @@ int main(int argc, char** argv) {
 
     app.add_flag("--no-color", no_color, "Disable colored output");
 
+    std::string snapshot_file;
+    app.add_option("--snapshot", snapshot_file, "Use devices from a snapshot file instead of scanning")
+       ->check(CLI::ExistingFile);
+
     auto* list_cmd = app.add_subcommand("list", "List hardware drivers");
     list_cmd->alias("ls");
 
@@ -76,12 +87,83 @@ int main(int argc, char** argv) {
     remove_cmd->add_flag("--usb", remove_usb, "Remove USB driver");
     remove_cmd->add_flag("-y,--noconfirm", no_confirm, "Skip confirmation prompt");
 
+    auto* auto_cmd = app.add_subcommand("auto", "Show the best drivers for detected hardware (dry run)");
+
+    std::string auto_drivers = "nonfree";
+    std::string auto_class;
+    bool auto_usb = false;
+
+    auto_cmd->add_option("drivers", auto_drivers, "Driver selection: free or nonfree")
+            ->check(CLI::IsMember({"free", "nonfree"}));
+    auto_cmd->add_option("class", auto_class, "Only devices of this class ID (e.g., 0300)");
+    auto_cmd->add_flag("--usb", auto_usb, "Select USB drivers instead of PCI");
+
+    auto* scan_cmd = app.add_subcommand("scan", "Scan hardware devices");
+
+    std::string scan_backend;
+    std::string scan_sysfs_root;
+    int scan_repeat = 0;
+    std::string scan_export;
+
+    scan_cmd->add_option("--backend", scan_backend, "Scan backend: udev or sysfs")
+            ->check(CLI::IsMember({"udev", "sysfs"}));
+    scan_cmd->add_option("--sysfs-root", scan_sysfs_root, "Sysfs root for the sysfs backend (e.g., a test fixture)");
+    scan_cmd->add_option("--time", scan_repeat, "Time N scans with each backend instead of listing devices")
+            ->check(CLI::PositiveNumber);
+    scan_cmd->add_option("--export", scan_export, "Write a device snapshot to file ('-' for stdout)");
+
+    auto* match_cmd = app.add_subcommand("match", "Match device snapshots of many machines against the driver database");
+
+    std::string match_snapshots;
+    std::size_t match_jobs = 0;
+    bool match_summary = false;
+
+    match_cmd->add_option("--snapshots", match_snapshots, "Directory of snapshots from 'scan --export'")
+             ->required()
+             ->check(CLI::ExistingDirectory);
+    match_cmd->add_option("-j,--jobs", match_jobs, "Worker threads (default: one per core)");
+    match_cmd->add_flag("-s,--summary", match_summary, "Only print the per-config histogram");
+
     app.require_subcommand(1);
 
     CLI11_PARSE(app, argc, argv);
 
-    mcp::mhwd::DeviceProvider device_provider;
-    coro::sync_wait(device_provider.scan());
+    if (*scan_cmd) {
+        // scan always reads the hardware, snapshots only stand in for it in the other commands
+        if (!snapshot_file.empty()) {
+            fmt::print(stderr, "--snapshot cannot be used with scan\n");
+            return 1;
+        }
+
+        auto options = mcp::mhwd::ScanOptions::from_environment();
+        if (!scan_backend.empty()) {
+            options.backend = scan_backend == "sysfs" ? mcp::mhwd::ScanBackend::Sysfs : mcp::mhwd::ScanBackend::Udev;
+        }
+        if (!scan_sysfs_root.empty()) {
+            options.sysfs_root = scan_sysfs_root;
+        }
+
+        return ScanCommand(std::move(options), scan_repeat, scan_export, !no_color).execute();
+    }
+
+    std::unique_ptr<mcp::mhwd::DeviceProvider> device_provider_ptr;
+    if (!snapshot_file.empty()) {
+        auto snapshot = mcp::mhwd::load_snapshot(snapshot_file);
+        if (!snapshot) {
+            fmt::print(stderr, "Failed to load snapshot '{}'\n", snapshot_file);
+            return 1;
+        }
+        device_provider_ptr = std::make_unique<mcp::mhwd::DeviceProvider>(*snapshot);
+    } else {
+        device_provider_ptr = std::make_unique<mcp::mhwd::DeviceProvider>();
+
+        // Only list and auto look at local hardware, match brings its own devices
+        if (*list_cmd || *auto_cmd) {
+            coro::sync_wait(device_provider_ptr->scan());
+        }
+    }
+
+    auto& device_provider = *device_provider_ptr;
     
     mcp::mhwd::ConfigProvider config_provider(device_provider);
 
@@ -98,6 +180,16 @@ int main(int argc, char** argv) {
         ).execute();
     }
 
+    if (*match_cmd) {
+        return MatchCommand(
+            config_provider,
+            match_snapshots,
+            match_jobs,
+            match_summary,
+            !no_color
+        ).execute();
+    }
+
     if (*install_cmd) {
         mcp::mhwd::BusType type = install_pci ? mcp::mhwd::BusType::PCI : mcp::mhwd::BusType::USB;
         return InstallCommand(
@@ -121,5 +213,28 @@ int main(int argc, char** argv) {
         ).execute();
     }
 
+    if (*auto_cmd) {
+        std::optional<mcp::mhwd::HardwareId> class_id;
+        if (!auto_class.empty()) {
+            // Whole string, in range, like IDs in configs and snapshots
+            mcp::mhwd::HardwareId id = 0;
+            const auto* end = auto_class.data() + auto_class.size();
+            auto [ptr, ec] = std::from_chars(auto_class.data(), end, id, 16);
+            if (ec != std::errc{} || ptr != end) {
+                fmt::print(stderr, "Invalid class ID '{}'\n", auto_class);
+                return 1;
+            }
+            class_id = id;
+        }
+
+        return AutoCommand(
+            config_provider,
+            auto_usb ? mcp::mhwd::BusType::USB : mcp::mhwd::BusType::PCI,
+            auto_drivers == "free" ? mcp::mhwd::DriverSelection::Free : mcp::mhwd::DriverSelection::NonFree,
+            class_id,
+            !no_color
+        ).execute();
+    }
+
     return 0;
 }
@@ -22,6 +22,12 @@
 #   QML_FILES - List of QML files to include in the module
 #   CPP_BACKING_LIBS - Optional C++ libraries to link (ViewModels, etc.)
 #
+# QML files are compiled at build time by qmlcachegen: bytecode for every
+# file, plus C++ for bindings and functions whose types it can resolve, so
+# nothing is parsed or compiled when a page is first shown. Configure with
+# -DMCP_QML_AOT=OFF to ship plain QML, e.g. for editing installed files.
+# -DQT_QMLCACHEGEN_ARGUMENTS=--verbose lists what falls back to bytecode.
+#
 function(mcp_add_qml_module)
     set(options "")
     set(oneValueArgs MODULE_NAME URI DOMAIN)
@@ -45,12 +51,29 @@ function(mcp_add_qml_module)
         message(FATAL_ERROR "mcp_add_qml_module: QML_FILES is required")
     endif()
     
+    set(cachegen_args "")
+    if(NOT MCP_QML_AOT)
+        set(cachegen_args NO_CACHEGEN)
+    endif()
+
+    # Remaining arguments are forwarded to qt_add_qml_module. Type information
+    # of QtQuick and the sibling MCP modules lets qmlcachegen compile bindings
+    # to C++ instead of leaving them to the interpreter.
     ecm_add_qml_module(${ARG_MODULE_NAME}
         URI "${ARG_URI}"
         VERSION 1.0
         GENERATE_PLUGIN_SOURCE
         OUTPUT_DIRECTORY ${CMAKE_BINARY_DIR}/bin/org/manjaro/mcp/${ARG_DOMAIN}
+        DEPENDENCIES QtQuick
+        IMPORT_PATH ${CMAKE_BINARY_DIR}/bin
+        ${cachegen_args}
     )
+
+    if(QT_QMLCACHEGEN_ARGUMENTS)
+        set_target_properties(${ARG_MODULE_NAME} PROPERTIES
+            QT_QMLCACHEGEN_ARGUMENTS "${QT_QMLCACHEGEN_ARGUMENTS}"
+        )
+    endif()
     
     ecm_target_qml_sources(${ARG_MODULE_NAME} SOURCES ${ARG_QML_FILES})
     
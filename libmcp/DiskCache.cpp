@@ -0,0 +1,177 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "DiskCache.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace mcp::cache {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::string_view c_header = "# mcp cache 2";
+
+// Stamps can be long (device lists), only a digest is kept in the file
+std::uint64_t fnv1a(std::string_view text)
+{
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+std::string digest_line(std::string_view stamp)
+{
+    return std::format("{:016x}", fnv1a(stamp));
+}
+
+fs::path entry_path(std::string_view name)
+{
+    return directory() / std::format("{}.cache", name);
+}
+
+bool write_all(int fd, std::string_view bytes)
+{
+    while (!bytes.empty()) {
+        const auto written = ::write(fd, bytes.data(), bytes.size());
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes.remove_prefix(static_cast<std::size_t>(written));
+    }
+    return true;
+}
+
+} // namespace
+
+fs::path directory()
+{
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+        return fs::path(xdg) / "mcp";
+    }
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return fs::path(home) / ".cache" / "mcp";
+    }
+    return {};
+}
+
+std::string stamp_paths(std::span<const fs::path> paths)
+{
+    std::string stamp;
+
+    for (const auto& path : paths) {
+        std::error_code ec;
+        const auto status = fs::status(path, ec);
+        if (ec || !fs::exists(status)) {
+            stamp += std::format("{} -\n", path.string());
+            continue;
+        }
+
+        const auto mtime = fs::last_write_time(path, ec).time_since_epoch().count();
+        const auto size = fs::is_regular_file(status) ? fs::file_size(path, ec) : 0;
+        stamp += std::format("{} {} {}\n", path.string(), mtime, size);
+    }
+
+    return stamp;
+}
+
+std::string pacman_stamp()
+{
+    std::vector<fs::path> paths{fs::path(c_pacman_local_dir)};
+
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(c_pacman_sync_dir, ec)) {
+        if (entry.path().extension() == ".db") {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin() + 1, paths.end());
+
+    return stamp_paths(paths);
+}
+
+std::optional<std::string> load(std::string_view name, std::string_view stamp)
+{
+    if (directory().empty()) {
+        return std::nullopt;
+    }
+
+    std::ifstream file(entry_path(name), std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+
+    std::string header;
+    std::string digest;
+    std::string body_digest;
+    if (!std::getline(file, header) || header != c_header
+        || !std::getline(file, digest) || digest != digest_line(stamp)
+        || !std::getline(file, body_digest)) {
+        return std::nullopt;
+    }
+
+    // A body that does not hash to what was written is torn or corrupted
+    std::string body(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>{});
+    if (body_digest != digest_line(body)) {
+        return std::nullopt;
+    }
+    return body;
+}
+
+bool store(std::string_view name, std::string_view stamp, std::string_view data)
+{
+    const auto dir = directory();
+    if (dir.empty()) {
+        return false;
+    }
+
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec) {
+        return false;
+    }
+
+    // mkstemp gives every writer, process or thread, a temporary of its own
+    const auto target = entry_path(name);
+    std::string temp = target.string() + ".XXXXXX";
+    const int fd = ::mkstemp(temp.data());
+    if (fd < 0) {
+        return false;
+    }
+
+    const auto header = std::format("{}\n{}\n{}\n", c_header, digest_line(stamp), digest_line(data));
+    const bool written = write_all(fd, header) && write_all(fd, data);
+    if (::close(fd) != 0 || !written) {
+        fs::remove(temp, ec);
+        return false;
+    }
+
+    fs::rename(temp, target, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace mcp::cache
@@ -0,0 +1,67 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace mcp::cache {
+
+/*
+ * Per-user cache of expensive results, shared by every frontend
+ * (KCMs, standalone and classic apps) of the same user.
+ *
+ * Each entry is stored with a stamp describing the inputs it was built
+ * from. A stamp that no longer matches makes the entry a miss, so stale
+ * data is never returned and nothing has to be explicitly invalidated.
+ *
+ * Usage:
+ *   auto stamp = cache::stamp_paths({"/var/lib/pacman/local"});
+ *   if (auto text = cache::load("kernels", stamp)) { ... }
+ *   cache::store("kernels", stamp, serialized);
+ */
+
+inline constexpr std::string_view c_pacman_local_dir = "/var/lib/pacman/local";
+inline constexpr std::string_view c_pacman_sync_dir = "/var/lib/pacman/sync";
+
+/**
+ * $XDG_CACHE_HOME/mcp, or ~/.cache/mcp when XDG_CACHE_HOME is unset.
+ */
+[[nodiscard]] std::filesystem::path directory();
+
+/**
+ * Modification time and size of each path, in the given order.
+ *
+ * Directories contribute their own mtime only, which changes whenever an
+ * entry is added, removed or renamed in them - enough for pacman's local
+ * database, where every transaction replaces package directories.
+ * Missing paths are recorded as such.
+ */
+[[nodiscard]] std::string stamp_paths(std::span<const std::filesystem::path> paths);
+
+/**
+ * Stamp of pacman's local database and every sync database.
+ */
+[[nodiscard]] std::string pacman_stamp();
+
+/**
+ * Cached data for name if it was stored with the same stamp and its
+ * body still matches the checksum written along with it.
+ */
+[[nodiscard]] std::optional<std::string> load(std::string_view name, std::string_view stamp);
+
+/**
+ * Replace the entry atomically, readers see either the old or the new file.
+ * Failures are not fatal, the cache is only an optimization.
+ */
+bool store(std::string_view name, std::string_view stamp, std::string_view data);
+
+} // namespace mcp::cache
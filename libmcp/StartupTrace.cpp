@@ -0,0 +1,217 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "StartupTrace.hpp"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace mcp::trace {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Event {
+    std::string name;
+    char phase;              // 'X' complete, 'i' instant
+    Clock::time_point start;
+    Clock::duration duration{};
+    int thread;
+};
+
+int current_thread()
+{
+    return static_cast<int>(::syscall(SYS_gettid));
+}
+
+// steady_clock is CLOCK_MONOTONIC, traces of several processes line up
+std::int64_t micros(Clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+std::string escape(std::string_view text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+class Tracer {
+public:
+    static Tracer& instance()
+    {
+        // Never destroyed, Scopes may still end during static destruction
+        static auto* tracer = new Tracer;
+        return *tracer;
+    }
+
+    bool enabled() const { return !path_.empty(); }
+
+    void record(Event event)
+    {
+        std::lock_guard lock(mutex_);
+        if (written_) {
+            return;
+        }
+        if (events_.size() >= c_max_events) {
+            ++dropped_;
+            return;
+        }
+        events_.push_back(std::move(event));
+    }
+
+    void ready(std::string_view name)
+    {
+        const auto now = Clock::now();
+
+        {
+            std::lock_guard lock(mutex_);
+            if (ready_at_) {
+                return;
+            }
+            ready_at_ = now;
+        }
+
+        record({std::string(name), 'i', now, {}, current_thread()});
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - origin_);
+        if (budget_ && elapsed > *budget_) {
+            std::fprintf(stderr, "mcp: startup took %lld ms, over the %lld ms budget, see %s\n",
+                         static_cast<long long>(elapsed.count()), static_cast<long long>(budget_->count()),
+                         path_.c_str());
+        }
+    }
+
+private:
+    Tracer()
+        : origin_(Clock::now())
+    {
+        if (const char* path = std::getenv("MCP_TRACE_STARTUP"); path && *path) {
+            path_ = path;
+            std::atexit([] { instance().write(); });
+        }
+        if (const char* budget = std::getenv("MCP_TRACE_BUDGET_MS"); budget && *budget) {
+            budget_ = std::chrono::milliseconds(std::strtoll(budget, nullptr, 10));
+        }
+    }
+
+    void write()
+    {
+        std::lock_guard lock(mutex_);
+        written_ = true;
+
+        if (dropped_ > 0) {
+            std::fprintf(stderr, "mcp: startup trace dropped %zu events past the first %zu\n",
+                         dropped_, c_max_events);
+        }
+
+        std::ofstream file(path_, std::ios::trunc);
+        if (!file) {
+            std::fprintf(stderr, "mcp: cannot write startup trace to %s\n", path_.c_str());
+            return;
+        }
+
+        const int pid = static_cast<int>(::getpid());
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        file << std::format(R"({{"name":"process_name","ph":"M","pid":{},"tid":{},"args":{{"name":"{}"}}}})",
+                            pid, pid, escape(program_name()));
+
+        for (const auto& event : events_) {
+            file << ",\n";
+            if (event.phase == 'X') {
+                file << std::format(R"({{"name":"{}","cat":"startup","ph":"X","ts":{},"dur":{},"pid":{},"tid":{}}})",
+                                    escape(event.name), micros(event.start.time_since_epoch()),
+                                    micros(event.duration), pid, event.thread);
+            } else {
+                file << std::format(R"({{"name":"{}","cat":"startup","ph":"i","s":"p","ts":{},"pid":{},"tid":{}}})",
+                                    escape(event.name), micros(event.start.time_since_epoch()), pid, event.thread);
+            }
+        }
+
+        file << "\n]}\n";
+    }
+
+    static std::string program_name()
+    {
+        std::ifstream comm("/proc/self/comm");
+        std::string name;
+        std::getline(comm, name);
+        return name;
+    }
+
+    std::filesystem::path path_;
+    std::optional<std::chrono::milliseconds> budget_;
+    Clock::time_point origin_;
+
+    std::mutex mutex_;
+    std::vector<Event> events_;
+    std::size_t dropped_ = 0;
+    std::optional<Clock::time_point> ready_at_;
+    bool written_ = false;
+};
+
+} // namespace
+
+bool enabled()
+{
+    return Tracer::instance().enabled();
+}
+
+void instant(std::string_view name)
+{
+    if (enabled()) {
+        Tracer::instance().record({std::string(name), 'i', Clock::now(), {}, current_thread()});
+    }
+}
+
+void ready(std::string_view name)
+{
+    if (enabled()) {
+        Tracer::instance().ready(name);
+    }
+}
+
+Scope::Scope(std::string_view name)
+{
+    if (enabled()) {
+        begin(std::string(name));
+    }
+}
+
+void Scope::begin(std::string name)
+{
+    name_ = std::move(name);
+    start_ = Clock::now();
+    thread_ = current_thread();
+}
+
+Scope::~Scope()
+{
+    if (thread_ != 0) {
+        Tracer::instance().record({std::move(name_), 'X', start_, Clock::now() - start_, thread_});
+    }
+}
+
+} // namespace mcp::trace
@@ -0,0 +1,86 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace mcp::trace {
+
+/*
+ * Startup tracer producing Chrome trace-event JSON, viewable in
+ * chrome://tracing or ui.perfetto.dev.
+ *
+ * Disabled unless MCP_TRACE_STARTUP names an output file, in which case
+ * every event is recorded with monotonic timestamps and the file is
+ * written at process exit. When MCP_TRACE_BUDGET_MS is set as well,
+ * ready() reports startups exceeding the budget on stderr. Startup is
+ * measured from the first traced call, so main() should make one early.
+ * Events past c_max_events are dropped and counted on stderr.
+ *
+ * Disabled calls only test a flag, so phases may stay instrumented.
+ * Formatted Scope names are only built when tracing is enabled.
+ *
+ * Usage:
+ *   {
+ *       trace::Scope scope("pamac::Database::initialize");
+ *       ...
+ *   }
+ *   trace::Scope scope("ConfigProvider::load_configs {}", to_string(type));
+ *   trace::ready("first frame");
+ */
+
+inline constexpr std::size_t c_max_events = 100'000;
+
+[[nodiscard]] bool enabled();
+
+/**
+ * Point in time on the startup timeline.
+ */
+void instant(std::string_view name);
+
+/**
+ * End of startup: records an instant event and checks the budget.
+ * Only the first call counts.
+ */
+void ready(std::string_view name);
+
+/**
+ * Complete event from construction to destruction. May be moved between
+ * threads, as coroutine frames are, and is attributed to the starting one.
+ */
+class Scope {
+public:
+    explicit Scope(std::string_view name);
+
+    template<typename Arg, typename... Args>
+    Scope(std::format_string<Arg, Args...> format, Arg&& arg, Args&&... args)
+    {
+        if (enabled()) {
+            begin(std::format(format, std::forward<Arg>(arg), std::forward<Args>(args)...));
+        }
+    }
+
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    void begin(std::string name);
+
+    std::string name_;
+    std::chrono::steady_clock::time_point start_;
+    int thread_ = 0;
+};
+
+} // namespace mcp::trace
@@ -14,6 +14,7 @@
 #include <coro/io_scheduler.hpp>
 #include <coro/task.hpp>
 
+#include <cstddef>
 #include <expected>
 #include <memory>
 
@@ -28,6 +29,10 @@ using Result = std::expected<T, E>;
 template<typename T, typename E>
 using ResultTask = Task<Result<T, E>>;
 
+namespace detail {
+inline thread_local bool on_io_scheduler = false;
+}
+
 /**
  * Global I/O scheduler for async operations.
  * Used by providers for expensive I/O operations with thread pool backing.
@@ -36,11 +41,23 @@ inline coro::io_scheduler& io_scheduler()
 {
     static auto scheduler = coro::io_scheduler::make_unique(
         coro::io_scheduler::options{
-            .pool = coro::thread_pool::options{.thread_count = std::thread::hardware_concurrency()},
+            .pool = coro::thread_pool::options{
+                .thread_count = std::thread::hardware_concurrency(),
+                .on_thread_start_functor = [](std::size_t) { detail::on_io_scheduler = true; },
+            },
             .execution_strategy = coro::io_scheduler::execution_strategy_t::process_tasks_on_thread_pool
         }
     );
     return *scheduler;
 }
 
+/**
+ * Whether the calling thread belongs to io_scheduler(), where blocking
+ * on work that itself needs the scheduler may deadlock.
+ */
+inline bool on_io_scheduler()
+{
+    return detail::on_io_scheduler;
+}
+
 } // namespace mcp
@@ -56,6 +56,8 @@ struct KernelFlags {
     bool real_time : 1 = false;
     bool in_use : 1 = false;
     bool experimental : 1 = false;
+
+    bool operator==(const KernelFlags& rhs) const = default;
 };
 
 /**
@@ -7,9 +7,16 @@
 
 #include "KernelProvider.hpp"
 
+#include "../DiskCache.hpp"
+#include "../StartupTrace.hpp"
+
 #include <algorithm>
 #include <array>
+#include <charconv>
+#include <ranges>
 #include <regex>
+#include <string_view>
+#include <vector>
 
 #ifdef __linux__
 #include <sys/utsname.h>
@@ -52,10 +59,102 @@ bool is_experimental_kernel(const std::string& name)
     return name.contains("-rc") || name.contains("-git");
 }
 
+constexpr std::string_view c_cache_name = "kernels";
+
+// One kernel per line, tab separated, extra modules comma separated:
+// <package> <major> <minor> <patch> <flags> <repo> <installed> <available> <changelog> <modules>
+std::string serialize_kernels(const KernelVector& kernels)
+{
+    std::string text;
+
+    for (const auto& kernel : kernels) {
+        const auto& f = kernel.flags;
+        const unsigned flags = unsigned{f.lts} << 0 | unsigned{f.recommended} << 1
+                             | unsigned{f.installed} << 2 | unsigned{f.not_supported} << 3
+                             | unsigned{f.real_time} << 4 | unsigned{f.in_use} << 5
+                             | unsigned{f.experimental} << 6;
+
+        std::string modules;
+        for (const auto& module : kernel.extra_modules) {
+            if (!modules.empty()) {
+                modules += ',';
+            }
+            modules += module;
+        }
+
+        for (const auto& field : {kernel.package_name, std::to_string(kernel.version.major),
+                                  std::to_string(kernel.version.minor), kernel.version.patch,
+                                  std::to_string(flags), kernel.repo, kernel.installed_version,
+                                  kernel.available_version, kernel.changelog_url, modules}) {
+            text += field;
+            text += '\t';
+        }
+        text.back() = '\n';
+    }
+
+    return text;
+}
+
+std::optional<KernelVector> parse_kernels(std::string_view text)
+{
+    auto to_int = [](std::string_view field, auto& value) {
+        return std::from_chars(field.data(), field.data() + field.size(), value).ec == std::errc{};
+    };
+
+    KernelVector kernels;
+
+    for (auto line : text | std::views::split('\n')) {
+        if (std::ranges::empty(line)) {
+            continue;
+        }
+
+        auto fields = line
+            | std::views::split('\t')
+            | std::views::transform([](auto field) { return std::string_view(field); })
+            | std::ranges::to<std::vector<std::string_view>>();
+        if (fields.size() != 10) {
+            return std::nullopt;
+        }
+
+        Kernel kernel;
+        unsigned flags = 0;
+        if (!to_int(fields[1], kernel.version.major) || !to_int(fields[2], kernel.version.minor)
+            || !to_int(fields[4], flags)) {
+            return std::nullopt;
+        }
+
+        kernel.package_name = fields[0];
+        kernel.version.patch = fields[3];
+        kernel.flags.lts = (flags & (1u << 0)) != 0;
+        kernel.flags.recommended = (flags & (1u << 1)) != 0;
+        kernel.flags.installed = (flags & (1u << 2)) != 0;
+        kernel.flags.not_supported = (flags & (1u << 3)) != 0;
+        kernel.flags.real_time = (flags & (1u << 4)) != 0;
+        kernel.flags.in_use = (flags & (1u << 5)) != 0;
+        kernel.flags.experimental = (flags & (1u << 6)) != 0;
+        kernel.repo = fields[5];
+        kernel.installed_version = fields[6];
+        kernel.available_version = fields[7];
+        kernel.changelog_url = fields[8];
+
+        for (auto module : fields[9] | std::views::split(',')) {
+            if (!std::ranges::empty(module)) {
+                kernel.extra_modules.emplace_back(std::string_view(module));
+            }
+        }
+
+        kernels.push_back(std::move(kernel));
+    }
+
+    return kernels;
+}
+
 } // namespace
 
 KernelProvider::KernelProvider()
 {
+    trace::Scope scope("KernelProvider::KernelProvider");
+
     pamac::Database::initialize("/etc/pamac.conf");
     pamac::Database::instance().value().get();    
 }
@@ -201,6 +300,18 @@ void KernelProvider::populate_kernel_metadata(Kernel& kernel) const
 
 Task<KernelResult<KernelVector>> KernelProvider::get_kernels(ProgressCallback progress) const
 {
+    trace::Scope scope("KernelProvider::get_kernels");
+
+    // The catalog only depends on the pacman databases and the running kernel,
+    // stamp them before reading so a concurrent transaction can only cause a miss
+    const auto stamp = cache::pacman_stamp() + "release " + get_running_kernel_version() + "\n";
+
+    if (auto cached = cache::load(c_cache_name, stamp)) {
+        if (auto kernels = parse_kernels(*cached)) {
+            co_return std::move(*kernels);
+        }
+    }
+
     auto packages = co_await pamac::Database::instance().value().get().search_pkgs_async("linux");
 
     KernelVector kernels;
@@ -259,6 +370,8 @@ Task<KernelResult<KernelVector>> KernelProvider::get_kernels(ProgressCallback pr
         progress(total, total, "");
     }
 
+    cache::store(c_cache_name, stamp, serialize_kernels(kernels));
+
     co_return kernels;
 }
 
@@ -0,0 +1,102 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * BatchMatcher - match many device snapshots against the config database.
+ * Used to audit which driver configs apply across a fleet of machines.
+ */
+
+#pragma once
+
+#include "../Types.hpp"
+#include "Config.hpp"
+#include "Device.hpp"
+#include "Types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace mcp::mhwd {
+
+class ConfigIndex;
+class ConfigProvider;
+
+/**
+ * Matching configs of one machine.
+ */
+struct MachineMatch {
+    std::filesystem::path snapshot;
+    std::size_t device_count = 0;
+    Result<std::vector<const Config*>, Error> configs;  // Grouped by bus, priority order within a bus
+};
+
+/**
+ * Number of machines a config matched on.
+ */
+struct ConfigCount {
+    const Config* config;
+    std::size_t machines;
+};
+
+struct BatchReport {
+    std::vector<MachineMatch> machines;  // In snapshot order
+    std::vector<ConfigCount> histogram;  // Most common first
+    std::size_t failed = 0;              // Snapshots that could not be loaded
+};
+
+/**
+ * Matcher over a fixed set of config indices.
+ *
+ * The available config database is taken from a ConfigProvider once, at
+ * construction, and shared read-only between worker threads. Config
+ * pointers in results stay valid for the lifetime of the matcher, even
+ * if the provider is reloaded in the meantime.
+ *
+ * Usage:
+ *   BatchMatcher matcher(config_provider);
+ *   auto snapshots = BatchMatcher::find_snapshots("fleet/");
+ *   auto report = matcher.match_snapshots(snapshots);
+ */
+class BatchMatcher {
+public:
+    explicit BatchMatcher(const ConfigProvider& provider);
+    ~BatchMatcher();
+
+    BatchMatcher(const BatchMatcher&) = delete;
+    BatchMatcher& operator=(const BatchMatcher&) = delete;
+
+    /**
+     * Configs whose every pattern is satisfied by the devices, as
+     * ConfigProvider::find_matching_configs() does for the local machine.
+     */
+    [[nodiscard]] std::vector<const Config*> match(DeviceVector devices) const;
+
+    /**
+     * Load and match snapshot files in parallel.
+     *
+     * @param workers thread count, 0 for one per core
+     */
+    [[nodiscard]] BatchReport
+    match_snapshots(std::span<const std::filesystem::path> snapshots, std::size_t workers = 0) const;
+
+    /**
+     * Regular files in dir (not recursive), sorted by name.
+     */
+    [[nodiscard]] static std::vector<std::filesystem::path>
+    find_snapshots(const std::filesystem::path& dir);
+
+private:
+    std::array<std::shared_ptr<const ConfigIndex>, c_bus_types.size()> indices_;
+
+    void match_range(std::span<MachineMatch> machines) const;
+};
+
+} // namespace mcp::mhwd
@@ -84,6 +84,8 @@ public:
     [[nodiscard]] const std::filesystem::path& config_file() const { return config_file_; }
 
 private:
+    friend class ConfigParser;
+
     std::string name_;
     std::string version_;
     std::string description_;
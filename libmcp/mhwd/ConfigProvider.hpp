@@ -16,23 +16,105 @@
 #include "Config.hpp"
 #include "DeviceProvider.hpp"
 
+#include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace mcp::mhwd {
 
+class ConfigIndex;
+class InstalledIndex;
+
+/**
+ * Everything needed to install a config, resolved in one lookup.
+ */
+struct InstallPlan {
+    Config config;
+    bool installed = false;     // Config itself is already installed
+    ConfigVector dependencies;  // Not yet installed, in install order
+    ConfigVector conflicts;     // Installed configs conflicting with config or its dependencies
+};
+
+/**
+ * Drivers auto-selection may choose from, as in "mhwd -a <bus> free|nonfree".
+ */
+enum class DriverSelection {
+    Free,       // Free drivers only
+    NonFree     // Any driver, highest priority wins
+};
+
+/**
+ * Best driver set for the detected hardware.
+ */
+struct AutoSelection {
+    ConfigVector selected;  // Chosen config per device, first device first
+    ConfigVector best;      // Best config per device, installed ones included
+    ConfigVector install;   // Selected configs and their dependencies, in install order
+};
+
 // Default paths for driver configs
 constexpr std::string_view c_pci_config_dir = "/var/lib/mhwd/db/pci";
 constexpr std::string_view c_usb_config_dir = "/var/lib/mhwd/db/usb";
 constexpr std::string_view c_pci_database_dir = "/var/lib/mhwd/local/pci";
 constexpr std::string_view c_usb_database_dir = "/var/lib/mhwd/local/usb";
+constexpr std::string_view c_sdio_config_dir = "/var/lib/mhwd/db/sdio";
+constexpr std::string_view c_sdio_database_dir = "/var/lib/mhwd/local/sdio";
+constexpr std::string_view c_hid_config_dir = "/var/lib/mhwd/db/hid";
+constexpr std::string_view c_hid_database_dir = "/var/lib/mhwd/local/hid";
+constexpr std::string_view c_thunderbolt_config_dir = "/var/lib/mhwd/db/thunderbolt";
+constexpr std::string_view c_thunderbolt_database_dir = "/var/lib/mhwd/local/thunderbolt";
 constexpr std::string_view c_config_filename = "MHWDCONFIG";
 
+/**
+ * Directory of available configs for a bus.
+ */
+constexpr std::string_view config_dir(BusType type)
+{
+    switch (type) {
+        case BusType::PCI:         return c_pci_config_dir;
+        case BusType::USB:         return c_usb_config_dir;
+        case BusType::SDIO:        return c_sdio_config_dir;
+        case BusType::HID:         return c_hid_config_dir;
+        case BusType::Thunderbolt: return c_thunderbolt_config_dir;
+    }
+    return c_pci_config_dir;
+}
+
+/**
+ * Directory of installed configs for a bus.
+ */
+constexpr std::string_view database_dir(BusType type)
+{
+    switch (type) {
+        case BusType::PCI:         return c_pci_database_dir;
+        case BusType::USB:         return c_usb_database_dir;
+        case BusType::SDIO:        return c_sdio_database_dir;
+        case BusType::HID:         return c_hid_database_dir;
+        case BusType::Thunderbolt: return c_thunderbolt_database_dir;
+    }
+    return c_pci_database_dir;
+}
+
 /**
  * Driver configuration provider.
  * 
  * Manages driver configuration queries and device-to-driver matching.
  * Does NOT handle transactions - use mhwd::build_install/build_remove for that.
  * 
+ * Available configs are parsed once per bus type and kept in an indexed
+ * cache - call reload() to pick up changes in /var/lib/mhwd/db.
+ * Generation counters let callers cache derived results (e.g. matches
+ * per device) and tell when they went stale.
+ * Installed configs are tracked incrementally: a query only rescans
+ * /var/lib/mhwd/local/<bus> when the directory's mtime changed, i.e. a
+ * config was installed or removed, and re-parses only the affected
+ * configs. Files edited in place are picked up by reload().
+ * 
  * Usage:
  *   DeviceProvider devices;
  *   co_await devices.scan();
@@ -47,17 +129,47 @@ public:
      * Construct provider with device provider.
      */
     explicit ConfigProvider(const DeviceProvider& device_provider);
+    ~ConfigProvider();
+
+    /**
+     * Re-check cached configs against disk.
+     * Available indexes are rebuilt only for buses whose database files
+     * or included files changed, installed configs are re-read on the next query.
+     */
+    void reload();
+
+    /**
+     * Bumped whenever the available index of the bus is rebuilt.
+     * Match results of one generation stay valid until it changes.
+     */
+    [[nodiscard]] std::uint64_t available_generation(BusType type) const;
+
+    /**
+     * Bumped whenever the installed set of the bus changes.
+     * Checks /var/lib/mhwd/local/<bus> like any installed query.
+     */
+    [[nodiscard]] std::uint64_t installed_generation(BusType type) const;
+
+    /**
+     * Fingerprint of everything matching results depend on: the available
+     * and installed config databases of every bus, the files the available
+     * configs include and the current device set. The include list is
+     * persisted by each parse, so the database is only parsed when its
+     * config files changed since.
+     * Lets frontends persist results across processes, see mcp::cache.
+     */
+    [[nodiscard]] std::string cache_stamp() const;
 
     // === Config queries ===
 
     /**
-     * Get all available configs from /var/lib/mhwd/db/{pci,usb}/
+     * Get all available configs from /var/lib/mhwd/db/<bus>/
      */
     [[nodiscard]] Task<ConfigVectorResult>
     get_available_configs(BusType type) const;
 
     /**
-     * Get installed configs from /var/lib/mhwd/local/{pci,usb}/
+     * Get installed configs from /var/lib/mhwd/local/<bus>/
      */
     [[nodiscard]] Task<ConfigVectorResult>
     get_installed_configs(BusType type) const;
@@ -68,6 +180,12 @@ public:
     [[nodiscard]] Task<ConfigResult>
     find_config(const std::string& name, BusType type) const;
 
+    /**
+     * Find installed config by name.
+     */
+    [[nodiscard]] Task<ConfigResult>
+    find_installed_config(const std::string& name, BusType type) const;
+
     // === Device matching ===
 
     /**
@@ -82,16 +200,39 @@ public:
     [[nodiscard]] Task<ConfigVector>
     find_matching_configs_for_device(const Device& device) const;
 
+    /**
+     * Pick the highest-priority config for every detected device of given bus.
+     *
+     * Devices already served by an installed config are skipped, that config
+     * is only reported in AutoSelection::best. A candidate
+     * is rejected if it, or any of its dependencies, conflicts with installed
+     * configs or configs chosen for earlier devices; the next one in
+     * priority order is tried instead.
+     *
+     * @param class_id restrict to devices of this class (e.g. 0x0300 for VGA)
+     */
+    [[nodiscard]] Task<Result<AutoSelection, Error>>
+    select_best(BusType type, DriverSelection drivers, std::optional<HardwareId> class_id = std::nullopt) const;
+
     // === Dependency analysis ===
 
     /**
-     * Resolve all dependencies for a config (transitive).
+     * Resolve dependencies and installed conflicts of an available config.
+     * Fails with Error::DependencyCycle if its dependencies loop.
+     */
+    [[nodiscard]] Task<Result<InstallPlan, Error>>
+    plan_install(const std::string& name, BusType type) const;
+
+    /**
+     * Resolve all dependencies for a config (transitive, install order).
+     * Returns nothing if the dependencies form a cycle.
      */
     [[nodiscard]] Task<ConfigVector>
     resolve_dependencies(const Config& config, BusType type) const;
 
     /**
-     * Find installed configs that conflict with given config.
+     * Find installed configs that conflict with given config or its dependencies,
+     * in either direction.
      */
     [[nodiscard]] Task<ConfigVector>
     find_conflicts(const Config& config, BusType type) const;
@@ -103,9 +244,42 @@ public:
     find_required_by(const Config& config, BusType type) const;
 
 private:
+    friend class BatchMatcher;
+
+    using IndexResult = Result<std::shared_ptr<const ConfigIndex>, Error>;
+
     const DeviceProvider& device_provider_;
 
-    [[nodiscard]] ConfigVectorResult
+    using FileStamps = std::vector<std::pair<std::filesystem::path, std::filesystem::file_time_type>>;
+
+    struct AvailableEntry {
+        std::shared_ptr<const ConfigIndex> index;
+        FileStamps stamps;          // Every file under the bus database
+        FileStamps include_stamps;  // Files pulled in via ">filename", wherever they live
+    };
+
+    mutable std::mutex cache_mutex_;
+    mutable std::unordered_map<BusType, AvailableEntry> available_cache_;
+    struct InstalledEntry {
+        std::unique_ptr<InstalledIndex> index;
+        std::optional<std::filesystem::file_time_type> mtime;  // Of the bus database when last scanned
+    };
+
+    mutable std::unordered_map<BusType, InstalledEntry> installed_cache_;
+    mutable std::unordered_map<BusType, std::uint64_t> available_generation_;
+    mutable std::unordered_map<BusType, std::uint64_t> installed_generation_;
+
+    [[nodiscard]] IndexResult available_index(BusType type) const;
+
+    template<typename Fn>
+    auto with_installed(BusType type, Fn&& fn) const;
+
+    struct LoadedConfigs {
+        ConfigVector configs;
+        FileStamps include_stamps;  // As read while parsing
+    };
+
+    [[nodiscard]] Result<LoadedConfigs, Error>
     load_configs_from_dir(const std::filesystem::path& dir, BusType type) const;
 
     [[nodiscard]] std::vector<std::filesystem::path>
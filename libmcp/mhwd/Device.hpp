@@ -13,11 +13,28 @@
 
 #include "Types.hpp"
 
+#include <cstddef>
+#include <functional>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace mcp::mhwd {
 
+/**
+ * Identity of a device across scans.
+ * The bus ID pins the slot, vendor:device tells a swapped card apart.
+ */
+struct DeviceKey {
+    BusType bus_type;
+    std::string bus_id;
+    HardwareId vendor_id;
+    HardwareId device_id;
+
+    bool operator==(const DeviceKey& other) const = default;
+};
+
 /**
  * Hardware device detected on the system.
  */
@@ -27,15 +44,15 @@ public:
 
     // === Hardware identification (for driver matching) ===
     
-    [[nodiscard]] const std::string& vendor_id() const { return vendor_id_; }
-    [[nodiscard]] const std::string& device_id() const { return device_id_; }
-    [[nodiscard]] const std::string& class_id() const { return class_id_; }
+    [[nodiscard]] HardwareId vendor_id() const { return vendor_id_; }
+    [[nodiscard]] HardwareId device_id() const { return device_id_; }
+    [[nodiscard]] HardwareId class_id() const { return class_id_; }
     
-    // === Human-readable information ===
+    // === Human-readable information (resolved from hwdb on first use) ===
     
-    [[nodiscard]] const std::string& vendor_name() const { return vendor_name_; }
-    [[nodiscard]] const std::string& device_name() const { return device_name_; }
-    [[nodiscard]] const std::string& class_name() const { return class_name_; }
+    [[nodiscard]] const std::string& vendor_name() const;
+    [[nodiscard]] const std::string& device_name() const;
+    [[nodiscard]] const std::string& class_name() const;
     
     // === System information ===
     
@@ -46,32 +63,67 @@ public:
     
     // === Device categorization ===
     
-    [[nodiscard]] DeviceCategory category() const;
+    [[nodiscard]] DeviceCategory category() const { return category_; }
+
+    // === Identity ===
+
+    [[nodiscard]] DeviceKey key() const { return {bus_type_, bus_id_, vendor_id_, device_id_}; }
+
+    /**
+     * Same key and same state (class, driver, sysfs path).
+     */
+    bool operator==(const Device& other) const = default;
 
 private:
     friend class Config;
+    friend class ConfigIndex;
     friend class ConfigProvider;
     [[nodiscard]] bool matches(const HardwarePattern& pattern) const;
 
     // Hardware IDs
-    std::string vendor_id_;
-    std::string device_id_;
-    std::string class_id_;
+    HardwareId vendor_id_;
+    HardwareId device_id_;
+    HardwareId class_id_;
+    BusType bus_type_;
+    DeviceCategory category_;
     
-    // Human-readable names
-    std::string vendor_name_;
-    std::string device_name_;
-    std::string class_name_;
+    // Descriptor name if the scanner had one, hwdb names are looked up by ID
+    NameHandle fallback_name_ = nullptr;
     
     // System paths
     std::string sysfs_path_;
     std::string bus_id_;
-    BusType bus_type_;
     std::string driver_;
 };
 
 using DeviceVector = std::vector<Device>;
 
 std::string_view to_string(DeviceCategory category);
+std::string_view to_string(BusType bus_type);
+
+/**
+ * Inverse of to_string(BusType), case-sensitive.
+ */
+std::optional<BusType> bus_type_from_string(std::string_view name);
+
+/**
+ * Stable textual form of a device key (e.g. "PCI/0000:01:00.0/10de:2204").
+ */
+std::string to_string(const DeviceKey& key);
+
+/**
+ * Format hardware ID as 4-digit lowercase hex for display (e.g. "10de").
+ */
+std::string to_hex_string(HardwareId id);
 
 } // namespace mcp::mhwd
+
+template<>
+struct std::hash<mcp::mhwd::DeviceKey> {
+    std::size_t operator()(const mcp::mhwd::DeviceKey& key) const noexcept
+    {
+        const std::size_t ids = (static_cast<std::size_t>(key.bus_type) << 32)
+            | (std::size_t{key.vendor_id} << 16) | key.device_id;
+        return std::hash<std::string>{}(key.bus_id) ^ (std::hash<std::size_t>{}(ids) << 1);
+    }
+};
@@ -0,0 +1,43 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Device set deltas - what changed between two scans.
+ */
+
+#pragma once
+
+#include "Device.hpp"
+
+#include <span>
+#include <vector>
+
+namespace mcp::mhwd {
+
+/**
+ * Single device added, removed or changed by hotplug or a rescan.
+ */
+struct DeviceChange {
+    enum class Kind { Added, Removed, Changed };
+
+    Kind kind;
+    Device device;  // New state, last known state for Removed
+};
+
+using DeviceChangeVector = std::vector<DeviceChange>;
+
+/**
+ * Deltas turning before into after, matched by Device::key().
+ *
+ * Removed devices come first in before order, then added and changed
+ * ones in after order. A device whose key is unchanged but whose state
+ * differs (e.g. another driver bound) is reported as Changed.
+ */
+[[nodiscard]] DeviceChangeVector
+diff_devices(std::span<const Device> before, std::span<const Device> after);
+
+} // namespace mcp::mhwd
@@ -14,14 +14,46 @@
 
 #include "../Types.hpp"
 #include "Device.hpp"
+#include "DeviceDiff.hpp"
+
+#include <sigc++/signal.h>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace mcp::mhwd {
 
+class DeviceMonitor;
+struct DeviceEvent;
+
+/**
+ * Where device IDs are read from during scan().
+ */
+enum class ScanBackend {
+    Udev,   // libudev enumeration and property database
+    Sysfs   // Direct sysfs attribute reads, names from hwdb afterwards
+};
+
+struct ScanOptions {
+    ScanBackend backend = ScanBackend::Udev;
+    std::filesystem::path sysfs_root = "/sys";   // Sysfs backend only
+
+    /**
+     * Defaults, overridden by MCP_MHWD_SCAN_BACKEND=udev|sysfs and MCP_MHWD_SYSFS_ROOT.
+     */
+    static ScanOptions from_environment();
+};
+
 /**
  * Hardware device provider using udev.
  * 
- * Scans PCI and USB buses to detect installed hardware.
- * Results are cached - call scan() to refresh.
+ * Scans PCI and USB buses to detect installed hardware. SDIO, HID and
+ * Thunderbolt are scanned too when /var/lib/mhwd/db has configs for them.
+ * Results are cached - call scan() to refresh, or start_monitoring()
+ * to keep the cache in sync with hotplug events.
  * 
  * Usage:
  *   DeviceProvider provider;
@@ -32,31 +64,74 @@ namespace mcp::mhwd {
  */
 class DeviceProvider {
 public:
-    DeviceProvider() = default;
+    explicit DeviceProvider(ScanOptions options = ScanOptions::from_environment());
 
     /**
-     * Get PCI devices (cached, call scan() to refresh).
+     * Replay a captured device set (see DeviceSnapshot.hpp).
+     * udev is never touched: scan() keeps the snapshot and monitoring is unavailable.
      */
-    [[nodiscard]] const DeviceVector& pci_devices() const { return pci_devices_; }
+    explicit DeviceProvider(const DeviceVector& snapshot);
+
+    ~DeviceProvider();
+
+    [[nodiscard]] const ScanOptions& options() const { return options_; }
 
     /**
-     * Get USB devices (cached, call scan() to refresh).
+     * Get devices of one bus (cached, call scan() to refresh).
      */
-    [[nodiscard]] const DeviceVector& usb_devices() const { return usb_devices_; }
+    [[nodiscard]] DeviceVector devices(BusType type) const;
+
+    [[nodiscard]] DeviceVector pci_devices() const { return devices(BusType::PCI); }
+    [[nodiscard]] DeviceVector usb_devices() const { return devices(BusType::USB); }
 
     /**
-     * Get all devices (PCI + USB).
+     * Get all devices of all scanned buses.
      */
     [[nodiscard]] DeviceVector all_devices() const;
 
+    /**
+     * Whether the bus is scanned at all.
+     */
+    [[nodiscard]] bool is_enabled(BusType type) const;
+
+    [[nodiscard]] bool is_snapshot() const { return snapshot_; }
+
     /**
      * Scan hardware and update cache.
+     * Buses are scanned concurrently on mcp::io_scheduler(), so the
+     * awaiting coroutine resumes on a scheduler thread.
      */
     Task<void> scan();
 
+    /**
+     * Apply udev add/remove/change events to the cache as they arrive.
+     * Returns false if the udev monitor could not be opened.
+     */
+    bool start_monitoring();
+
+    /**
+     * Stop applying hotplug events, blocks until the monitor has exited.
+     */
+    void stop_monitoring();
+
+    /**
+     * Emitted with the cache deltas of each hotplug batch, and of each
+     * scan() that found the hardware changed.
+     * Called from an io_scheduler thread, not the caller's.
+     */
+    sigc::signal<void(const DeviceChangeVector&)> signal_devices_changed;
+
 private:
-    DeviceVector pci_devices_;
-    DeviceVector usb_devices_;
+    void apply_events(std::vector<DeviceEvent> events);
+
+    ScanOptions options_;
+    std::array<bool, c_bus_types.size()> enabled_{};
+    bool snapshot_ = false;
+
+    mutable std::mutex mutex_;
+    std::array<DeviceVector, c_bus_types.size()> devices_;
+
+    std::unique_ptr<DeviceMonitor> monitor_;
 };
 
 } // namespace mcp::mhwd
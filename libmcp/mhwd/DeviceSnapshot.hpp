@@ -0,0 +1,48 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Device snapshots - capture DeviceProvider results for offline replay.
+ */
+
+#pragma once
+
+#include "../Types.hpp"
+#include "Device.hpp"
+#include "Types.hpp"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace mcp::mhwd {
+
+/**
+ * Snapshot text format, one device per line, tab separated:
+ *
+ *   # mcp-mhwd snapshot 1
+ *   <bus> <class> <vendor> <device> <bus id> <sysfs path> <driver> <name>
+ *
+ * IDs are 4-digit hex, bus is as printed by to_string(BusType). The
+ * header line is required and carries the format version; after it empty
+ * lines and lines starting with '#' are ignored. Names are informative
+ * only - on replay hwdb names win where available.
+ */
+inline constexpr std::string_view c_snapshot_header = "# mcp-mhwd snapshot 1";
+
+[[nodiscard]] std::string to_snapshot(const DeviceVector& devices);
+
+/**
+ * Parse snapshot text, fails with Error::ParseError on a missing or unknown
+ * header or a malformed line.
+ */
+[[nodiscard]] Result<DeviceVector, Error> parse_snapshot(std::string_view text);
+
+[[nodiscard]] Result<DeviceVector, Error> load_snapshot(const std::filesystem::path& path);
+[[nodiscard]] Result<void, Error> save_snapshot(const std::filesystem::path& path, const DeviceVector& devices);
+
+} // namespace mcp::mhwd
@@ -27,6 +27,7 @@ using CommandResult = Result<agent::Command, Error>;
  * - Config exists in repository
  * - Not already installed
  * - No conflicts with installed configs
+ * - Dependencies do not form a cycle
  * 
  * Includes all dependencies in correct order.
  */
@@ -37,6 +38,29 @@ build_install(
     BusType type
 );
 
+/**
+ * Build a single install command for the best drivers of all detected devices.
+ *
+ * Equivalent of "mhwd -a <bus> free|nonfree [class]": see
+ * ConfigProvider::select_best() for how configs are chosen.
+ * Fails with Error::AlreadyInstalled if there is nothing to install.
+ */
+[[nodiscard]] Task<CommandResult>
+build_auto_install(
+    const ConfigProvider& provider,
+    BusType type,
+    DriverSelection drivers,
+    std::optional<HardwareId> class_id = std::nullopt
+);
+
+/**
+ * Build the install command for a selection already made, e.g. one
+ * that was shown to the user first, so the command matches it exactly.
+ * Fails with Error::AlreadyInstalled if there is nothing to install.
+ */
+[[nodiscard]] CommandResult
+build_auto_install(const AutoSelection& selection);
+
 /**
  * Build remove command for a driver config.
  * 
@@ -11,14 +11,30 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace mcp::mhwd {
 
+/**
+ * Numeric vendor, device or class identifier.
+ * Class IDs carry base class and subclass (e.g. 0x0300).
+ */
+using HardwareId = std::uint16_t;
+
 enum class BusType { 
     PCI, 
-    USB 
+    USB,
+    SDIO,
+    HID,
+    Thunderbolt
+};
+
+inline constexpr std::array c_bus_types = {
+    BusType::PCI, BusType::USB, BusType::SDIO, BusType::HID, BusType::Thunderbolt
 };
 
 enum class DeviceCategory {
@@ -41,6 +57,7 @@ enum class Error {
     NotInstalled,
     HasConflicts,
     RequiredByOthers,
+    DependencyCycle,
     InvalidOperation,
     
     // Backend errors
@@ -48,24 +65,47 @@ enum class Error {
 };
 
 struct DeviceInfo {
-    std::string class_id;
-    std::string vendor_id;
-    std::string device_id;
-    std::string class_name;
-    std::string vendor_name;
-    std::string device_name;
+    HardwareId class_id = 0;
+    HardwareId vendor_id = 0;
+    HardwareId device_id = 0;
+    std::string device_name;    // Descriptor name, used when hwdb has no model entry
     std::string sysfs_bus_id;
     std::string sysfs_id;
     std::string driver;
 };
 
+/**
+ * Interned name owned by the process-wide hwdb name cache.
+ */
+using NameHandle = const std::string*;
+
+/**
+ * ID list from a config pattern, "*" in the config sets any.
+ * IDs are kept sorted for binary search. A list given in the config is
+ * present even if none of its IDs parsed, it then matches nothing instead
+ * of being widened to a wildcard like an absent one.
+ */
+struct IdList {
+    std::vector<HardwareId> ids;
+    bool any = false;
+    bool present = false;
+
+    // Not given in the config
+    [[nodiscard]] bool empty() const { return !any && !present && ids.empty(); }
+
+    [[nodiscard]] bool contains(HardwareId id) const
+    {
+        return any || std::ranges::binary_search(ids, id);
+    }
+};
+
 struct HardwarePattern {
-    std::vector<std::string> class_ids;
-    std::vector<std::string> vendor_ids;
-    std::vector<std::string> device_ids;
-    std::vector<std::string> blacklisted_class_ids;
-    std::vector<std::string> blacklisted_vendor_ids;
-    std::vector<std::string> blacklisted_device_ids;
+    IdList class_ids;
+    IdList vendor_ids;
+    IdList device_ids;
+    IdList blacklisted_class_ids;
+    IdList blacklisted_vendor_ids;
+    IdList blacklisted_device_ids;
 };
 
 } // namespace mcp::mhwd
@@ -0,0 +1,102 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Scan backend benchmark - libudev enumeration against direct sysfs reads.
+ *
+ * Both backends read /sys, so they always see the same tree. The
+ * bench-mhwd-scan target runs this under umockdev-wrapper with testbed/
+ * mapped over /sys and /run/udev, which makes that tree the checked-in
+ * 60-device fixture; started directly it measures the live system.
+ *
+ * Usage: mcp-mhwd-scan-bench [runs]
+ */
+
+#include <mhwd/DeviceProvider.hpp>
+
+#include <coro/sync_wait.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace mcp::mhwd;
+
+struct Run {
+    std::chrono::duration<double, std::milli> mean;
+    std::vector<std::string> devices;   // Everything but the name, sorted
+};
+
+Run run(ScanBackend backend, int repeat)
+{
+    DeviceProvider provider(ScanOptions{.backend = backend, .sysfs_root = "/sys"});
+
+    // The first scan pays for opening libudev and the page cache
+    coro::sync_wait(provider.scan());
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; ++i) {
+        coro::sync_wait(provider.scan());
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    Run result{std::chrono::duration<double, std::milli>(elapsed) / repeat, {}};
+
+    // Only PCI and USB have a sysfs backend
+    for (auto type : {BusType::PCI, BusType::USB}) {
+        for (const auto& device : provider.devices(type)) {
+            result.devices.push_back(fmt::format("{} {:04x}:{:04x}:{:04x} {} {} {}",
+                                                 to_string(type),
+                                                 device.class_id(),
+                                                 device.vendor_id(),
+                                                 device.device_id(),
+                                                 device.bus_id(),
+                                                 device.sysfs_path(),
+                                                 device.driver()));
+        }
+    }
+    std::ranges::sort(result.devices);
+
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int repeat = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+
+    const char* testbed = std::getenv("UMOCKDEV_DIR");
+    fmt::print("Scanning {} ({} runs per backend)\n", testbed ? testbed : "live /sys", repeat);
+
+    const auto udev = run(ScanBackend::Udev, repeat);
+    const auto sysfs = run(ScanBackend::Sysfs, repeat);
+
+    fmt::print("  udev   {:>9.3f} ms  ({} devices)\n", udev.mean.count(), udev.devices.size());
+    fmt::print("  sysfs  {:>9.3f} ms  ({} devices)\n", sysfs.mean.count(), sysfs.devices.size());
+
+    // A faster scan only counts if it finds the same devices
+    std::vector<std::string> only_udev;
+    std::vector<std::string> only_sysfs;
+    std::ranges::set_difference(udev.devices, sysfs.devices, std::back_inserter(only_udev));
+    std::ranges::set_difference(sysfs.devices, udev.devices, std::back_inserter(only_sysfs));
+
+    for (const auto& line : only_udev) {
+        fmt::print("  udev only:  {}\n", line);
+    }
+    for (const auto& line : only_sysfs) {
+        fmt::print("  sysfs only: {}\n", line);
+    }
+
+    return only_udev.empty() && only_sysfs.empty() ? 0 : 1;
+}
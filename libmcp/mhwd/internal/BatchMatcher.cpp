@@ -0,0 +1,167 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "mhwd/BatchMatcher.hpp"
+#include "mhwd/ConfigProvider.hpp"
+#include "mhwd/DeviceSnapshot.hpp"
+#include "ConfigIndex.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <thread>
+#include <unordered_map>
+
+/*
+ * Parallel snapshot matching over shared config indices.
+ */
+
+namespace rg = std::ranges;
+namespace vw = std::ranges::views;
+
+namespace mcp::mhwd {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Snapshots are small files, below this many per worker threads don't pay off
+constexpr std::size_t c_min_chunk_size = 4;
+
+std::size_t bus_index(BusType type)
+{
+    return static_cast<std::size_t>(type);
+}
+
+} // namespace
+
+BatchMatcher::BatchMatcher(const ConfigProvider& provider)
+{
+    // Buses without a config database simply never match
+    for (auto type : c_bus_types) {
+        if (auto index = provider.available_index(type)) {
+            indices_[bus_index(type)] = std::move(*index);
+        }
+    }
+}
+
+BatchMatcher::~BatchMatcher() = default;
+
+std::vector<const Config*> BatchMatcher::match(DeviceVector devices) const
+{
+    rg::stable_sort(devices, rg::less{}, &Device::bus_type);
+
+    std::vector<const Config*> matching;
+    std::span<const Device> remaining(devices);
+
+    while (!remaining.empty()) {
+        const auto type = remaining.front().bus_type();
+        const auto bus_end = rg::find_if(remaining, [type](const Device& device) {
+            return device.bus_type() != type;
+        });
+        const auto count = static_cast<std::size_t>(bus_end - remaining.begin());
+
+        if (const auto& index = indices_[bus_index(type)]) {
+            rg::copy(index->match(remaining.first(count)), std::back_inserter(matching));
+        }
+        remaining = remaining.subspan(count);
+    }
+
+    return matching;
+}
+
+void BatchMatcher::match_range(std::span<MachineMatch> machines) const
+{
+    for (auto& machine : machines) {
+        auto devices = load_snapshot(machine.snapshot);
+        if (!devices) {
+            machine.configs = std::unexpected(devices.error());
+            continue;
+        }
+
+        machine.device_count = devices->size();
+        machine.configs = match(std::move(*devices));
+    }
+}
+
+BatchReport
+BatchMatcher::match_snapshots(std::span<const fs::path> snapshots, std::size_t workers) const
+{
+    BatchReport report;
+    report.machines = snapshots
+        | vw::transform([](const fs::path& path) { return MachineMatch{.snapshot = path}; })
+        | rg::to<std::vector<MachineMatch>>();
+
+    if (workers == 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers = std::clamp<std::size_t>(report.machines.size() / c_min_chunk_size, 1, workers);
+
+    if (workers == 1) {
+        match_range(report.machines);
+    } else {
+        const std::size_t chunk_size = (report.machines.size() + workers - 1) / workers;
+        std::span<MachineMatch> machines(report.machines);
+
+        std::vector<std::jthread> threads;
+        threads.reserve(workers);
+
+        for (std::size_t i = 0; i < workers; ++i) {
+            const auto begin = std::min(i * chunk_size, machines.size());
+            const auto end = std::min(begin + chunk_size, machines.size());
+
+            // Workers only write their own slots, the indices are read-only
+            threads.emplace_back([this, chunk = machines.subspan(begin, end - begin)] {
+                match_range(chunk);
+            });
+        }
+    }
+
+    std::unordered_map<const Config*, std::size_t> counts;
+    for (const auto& machine : report.machines) {
+        if (!machine.configs) {
+            ++report.failed;
+            continue;
+        }
+        for (const auto* config : *machine.configs) {
+            ++counts[config];
+        }
+    }
+
+    report.histogram = counts
+        | vw::transform([](const auto& kv) { return ConfigCount{kv.first, kv.second}; })
+        | rg::to<std::vector<ConfigCount>>();
+
+    rg::sort(report.histogram, [](const ConfigCount& lhs, const ConfigCount& rhs) {
+        if (lhs.machines != rhs.machines) {
+            return lhs.machines > rhs.machines;
+        }
+        if (lhs.config->bus_type() != rhs.config->bus_type()) {
+            return lhs.config->bus_type() < rhs.config->bus_type();
+        }
+        return lhs.config->name() < rhs.config->name();
+    });
+
+    return report;
+}
+
+std::vector<fs::path> BatchMatcher::find_snapshots(const fs::path& dir)
+{
+    std::vector<fs::path> snapshots;
+
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        if (entry.is_regular_file()) {
+            snapshots.push_back(entry.path());
+        }
+    }
+
+    rg::sort(snapshots);
+    return snapshots;
+}
+
+} // namespace mcp::mhwd
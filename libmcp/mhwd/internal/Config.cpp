@@ -7,9 +7,13 @@
 
 #include "mhwd/Config.hpp"
 #include "mhwd/Types.hpp"
+#include "ConfigParser.hpp"
+#include "IncludeCache.hpp"
 #include "StringUtils.hpp"
 
 #include <algorithm>
+#include <charconv>
+#include <cstdio>
 #include <fstream>
 #include <functional>
 #include <unordered_map>
@@ -20,7 +24,7 @@
  * and dependency/conflict checking.
  */
 
-#define CFG_HANDLER [](Config& cfg, const std::string& val)
+#define CFG_HANDLER [](Config& cfg, const ConfigValue& val)
 
 namespace mcp::mhwd {
 
@@ -28,34 +32,6 @@ namespace {
 
 using namespace string_utils;
 
-// Read external file referenced by ">filename" syntax
-std::string read_external_file(const std::filesystem::path& file_path, const std::filesystem::path& base_path)
-{
-    std::filesystem::path full_path = file_path.is_absolute() ? file_path : base_path / file_path;
-
-    std::ifstream file(full_path);
-    if (!file.is_open()) {
-        return "";
-    }
-
-    std::string result;
-    std::string line;
-
-    while (std::getline(file, line)) {
-        const auto comment_pos = line.find('#');
-        if (comment_pos != std::string::npos) {
-            line = line.substr(0, comment_pos);
-        }
-
-        line = trim(line);
-        if (!line.empty()) {
-            result += " " + line;
-        }
-    }
-
-    return trim(result);
-}
-
 std::optional<std::string> preprocess_line(std::string line)
 {
     const auto comment_pos = line.find('#');
@@ -67,7 +43,26 @@ std::optional<std::string> preprocess_line(std::string line)
     return line.empty() ? std::nullopt : std::optional{line};
 }
 
-std::optional<std::pair<std::string, std::string>> parse_key_value(const std::string& line, const std::filesystem::path& base_path)
+// Value of a config key, either inline or shared contents of a ">filename" include
+struct ConfigValue {
+    std::string inline_text;
+    std::vector<std::string> inline_tokens;
+    std::shared_ptr<const IncludeFile> include;
+
+    [[nodiscard]] const std::string& text() const
+    {
+        return include ? include->text : inline_text;
+    }
+
+    [[nodiscard]] const std::vector<std::string>& tokens() const
+    {
+        return include ? include->tokens : inline_tokens;
+    }
+};
+
+std::optional<std::pair<std::string, ConfigValue>> parse_key_value(const std::string& line,
+                                                                   const std::filesystem::path& base_path,
+                                                                   IncludeCache& includes)
 {
     const auto equals_pos = line.find('=');
     if (equals_pos == std::string::npos) {
@@ -77,26 +72,76 @@ std::optional<std::pair<std::string, std::string>> parse_key_value(const std::st
     std::string key = to_lower(trim(line.substr(0, equals_pos)));
     std::string value = trim(trim_quotes(trim(line.substr(equals_pos + 1))));
 
+    ConfigValue result;
+
     // Handle external file references
     if (value.starts_with('>') && value.size() > 1) {
-        value = read_external_file(value.substr(1), base_path);
+        result.include = includes.get(value.substr(1), base_path);
+    } else {
+        result.inline_tokens = split_values(value);
+        result.inline_text = std::move(value);
     }
 
-    return std::pair{std::move(key), std::move(value)};
+    return std::pair{std::move(key), std::move(result)};
 }
 
-// Finalize patterns by adding wildcard defaults
+// Parse hex ID tokens, "*" matches any ID. Malformed IDs are skipped and
+// collected, a list made only of them is present but matches nothing.
+IdList parse_ids(const std::vector<std::string>& tokens, std::vector<std::string>& malformed)
+{
+    IdList list;
+    list.present = !tokens.empty();
+
+    for (const auto& token : tokens) {
+        if (token == "*") {
+            list.any = true;
+            continue;
+        }
+
+        HardwareId id = 0;
+        const auto* end = token.data() + token.size();
+        auto [ptr, ec] = std::from_chars(token.data(), end, id, 16);
+        if (ec == std::errc{} && ptr == end) {
+            list.ids.push_back(id);
+        } else {
+            malformed.push_back(token);
+        }
+    }
+
+    rg::sort(list.ids);
+    list.ids.erase(rg::unique(list.ids).begin(), list.ids.end());
+    return list;
+}
+
+// Set an ID list of the current pattern, starting a new pattern if it is already set
+void set_ids(std::vector<HardwarePattern>& patterns, IdList HardwarePattern::*member,
+             const ConfigValue& val, bool starts_pattern, const std::filesystem::path& file)
+{
+    std::vector<std::string> malformed;
+    auto ids = parse_ids(val.tokens(), malformed);
+
+    for (const auto& token : malformed) {
+        std::fprintf(stderr, "mcp: ignoring malformed ID \"%s\" in %s\n", token.c_str(), file.c_str());
+    }
+
+    if (starts_pattern && !(patterns.back().*member).empty()) {
+        patterns.push_back(HardwarePattern{});
+    }
+    patterns.back().*member = std::move(ids);
+}
+
+// Finalize patterns by adding wildcard defaults for absent keys
 void finalize_patterns(std::vector<HardwarePattern>& patterns)
 {
     for (auto& pattern : patterns) {
         if (pattern.class_ids.empty()) {
-            pattern.class_ids.push_back("*");
+            pattern.class_ids.any = true;
         }
         if (pattern.vendor_ids.empty()) {
-            pattern.vendor_ids.push_back("*");
+            pattern.vendor_ids.any = true;
         }
         if (pattern.device_ids.empty()) {
-            pattern.device_ids.push_back("*");
+            pattern.device_ids.any = true;
         }
     }
 }
@@ -104,6 +149,13 @@ void finalize_patterns(std::vector<HardwarePattern>& patterns)
 } // namespace
 
 std::expected<Config, ParseError> Config::from_file(const std::filesystem::path& path, BusType type)
+{
+    IncludeCache includes;
+    return ConfigParser::parse(path, type, includes);
+}
+
+std::expected<Config, ParseError>
+ConfigParser::parse(const std::filesystem::path& path, BusType type, IncludeCache& includes)
 {
     if (!std::filesystem::exists(path)) {
         return std::unexpected(ParseError{"File does not exist", path});
@@ -123,55 +175,46 @@ std::expected<Config, ParseError> Config::from_file(const std::filesystem::path&
         config.patterns_.push_back(HardwarePattern{});
     }
 
-    using KeyHandler = std::function<void(Config&, const std::string&)>;
+    using KeyHandler = std::function<void(Config&, const ConfigValue&)>;
     static const std::unordered_map<std::string, KeyHandler> key_handlers = {
         {"name", CFG_HANDLER {
-            cfg.name_ = to_lower(val);
+            cfg.name_ = to_lower(val.text());
         }},
         {"version", CFG_HANDLER {
-            cfg.version_ = val;
+            cfg.version_ = val.text();
         }},
         {"info", CFG_HANDLER {
-            cfg.description_ = val;
+            cfg.description_ = val.text();
         }},
         {"priority", CFG_HANDLER {
-            cfg.priority_ = std::stoi(val);
+            cfg.priority_ = std::stoi(val.text());
         }},
         {"freedriver", CFG_HANDLER {
-            cfg.is_free_driver_ = (to_lower(val) == "true");
+            cfg.is_free_driver_ = (to_lower(val.text()) == "true");
         }},
         {"classids", CFG_HANDLER {
-            if (!cfg.patterns_.back().class_ids.empty()) {
-                cfg.patterns_.push_back(HardwarePattern{});
-            }
-            cfg.patterns_.back().class_ids = split_values(val);
+            set_ids(cfg.patterns_, &HardwarePattern::class_ids, val, true, cfg.config_file_);
         }},
         {"vendorids", CFG_HANDLER {
-            if (!cfg.patterns_.back().vendor_ids.empty()) {
-                cfg.patterns_.push_back(HardwarePattern{});
-            }
-            cfg.patterns_.back().vendor_ids = split_values(val);
+            set_ids(cfg.patterns_, &HardwarePattern::vendor_ids, val, true, cfg.config_file_);
         }},
         {"deviceids", CFG_HANDLER {
-            if (!cfg.patterns_.back().device_ids.empty()) {
-                cfg.patterns_.push_back(HardwarePattern{});
-            }
-            cfg.patterns_.back().device_ids = split_values(val);
+            set_ids(cfg.patterns_, &HardwarePattern::device_ids, val, true, cfg.config_file_);
         }},
         {"blacklistedclassids", CFG_HANDLER {
-            cfg.patterns_.back().blacklisted_class_ids = split_values(val);
+            set_ids(cfg.patterns_, &HardwarePattern::blacklisted_class_ids, val, false, cfg.config_file_);
         }},
         {"blacklistedvendorids", CFG_HANDLER {
-            cfg.patterns_.back().blacklisted_vendor_ids = split_values(val);
+            set_ids(cfg.patterns_, &HardwarePattern::blacklisted_vendor_ids, val, false, cfg.config_file_);
         }},
         {"blacklisteddeviceids", CFG_HANDLER {
-            cfg.patterns_.back().blacklisted_device_ids = split_values(val);
+            set_ids(cfg.patterns_, &HardwarePattern::blacklisted_device_ids, val, false, cfg.config_file_);
         }},
         {"mhwddepends", CFG_HANDLER {
-            cfg.dependencies_ = split_values(val);
+            cfg.dependencies_ = val.tokens();
         }},
         {"mhwdconflicts", CFG_HANDLER {
-            cfg.conflicts_ = split_values(val);
+            cfg.conflicts_ = val.tokens();
         }}
     };
 
@@ -182,7 +225,7 @@ std::expected<Config, ParseError> Config::from_file(const std::filesystem::path&
             continue;
         }
 
-        auto kv = parse_key_value(*processed, config.base_path_);
+        auto kv = parse_key_value(*processed, config.base_path_, includes);
         if (!kv) {
             continue;
         }
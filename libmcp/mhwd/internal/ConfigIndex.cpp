@@ -0,0 +1,268 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "ConfigIndex.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+/*
+ * Inverted index construction and candidate lookup.
+ */
+
+namespace rg = std::ranges;
+namespace vw = std::ranges::views;
+
+namespace mcp::mhwd {
+
+namespace {
+
+bool is_concrete(const IdList& list)
+{
+    return !list.any && !list.ids.empty();
+}
+
+std::uint32_t vendor_device_key(HardwareId vendor_id, HardwareId device_id)
+{
+    return (std::uint32_t{vendor_id} << 16) | device_id;
+}
+
+// Drop repeated indices, keeping the first occurrence (preserves install order)
+void dedupe_stable(std::vector<std::uint32_t>& indices, std::size_t universe)
+{
+    std::vector<bool> seen(universe, false);
+    std::erase_if(indices, [&seen](std::uint32_t idx) {
+        if (seen[idx]) {
+            return true;
+        }
+        seen[idx] = true;
+        return false;
+    });
+}
+
+} // namespace
+
+ConfigIndex::ConfigIndex(ConfigVector configs)
+    : configs_(std::move(configs))
+{
+    rg::stable_sort(configs_, rg::greater{}, &Config::priority);
+
+    for (std::uint32_t config_idx = 0; config_idx < configs_.size(); ++config_idx) {
+        const auto& config = configs_[config_idx];
+        by_name_.emplace(config.name(), config_idx);
+
+        const auto& patterns = config.patterns();
+        for (std::uint32_t pattern_idx = 0; pattern_idx < patterns.size(); ++pattern_idx) {
+            add_pattern(patterns[pattern_idx], Entry{config_idx, pattern_idx});
+        }
+    }
+
+    build_dependency_graph();
+}
+
+void ConfigIndex::build_dependency_graph()
+{
+    // Dependencies missing from the database are skipped, as mhwd does
+    dependencies_.resize(configs_.size());
+    for (std::size_t idx = 0; idx < configs_.size(); ++idx) {
+        for (const auto& dep_name : configs_[idx].dependencies()) {
+            if (auto it = by_name_.find(dep_name); it != by_name_.end()) {
+                dependencies_[idx].push_back(it->second);
+            }
+        }
+    }
+
+    enum class Mark : std::uint8_t { Unvisited, Visiting, Done, Cycle };
+    std::vector<Mark> marks(configs_.size(), Mark::Unvisited);
+    closures_.resize(configs_.size());
+
+    // Post-order DFS: dependencies land before their dependents
+    auto visit = [&](const auto& self, std::uint32_t idx) -> bool {
+        switch (marks[idx]) {
+        case Mark::Done:
+            return true;
+        case Mark::Visiting:
+        case Mark::Cycle:
+            return false;
+        case Mark::Unvisited:
+            break;
+        }
+
+        marks[idx] = Mark::Visiting;
+
+        std::vector<std::uint32_t> closure;
+        for (auto dep : dependencies_[idx]) {
+            if (!self(self, dep)) {
+                marks[idx] = Mark::Cycle;
+                return false;
+            }
+            closure.insert(closure.end(), closures_[dep]->begin(), closures_[dep]->end());
+            closure.push_back(dep);
+        }
+
+        dedupe_stable(closure, configs_.size());
+        closures_[idx] = std::move(closure);
+        marks[idx] = Mark::Done;
+        return true;
+    };
+
+    for (std::uint32_t idx = 0; idx < configs_.size(); ++idx) {
+        visit(visit, idx);
+    }
+}
+
+void ConfigIndex::add_pattern(const HardwarePattern& pattern, Entry entry)
+{
+    if (is_concrete(pattern.vendor_ids) && is_concrete(pattern.device_ids)) {
+        for (auto vendor_id : pattern.vendor_ids.ids) {
+            for (auto device_id : pattern.device_ids.ids) {
+                by_vendor_device_[vendor_device_key(vendor_id, device_id)].push_back(entry);
+            }
+        }
+    } else if (is_concrete(pattern.class_ids)) {
+        for (auto class_id : pattern.class_ids.ids) {
+            by_class_[class_id].push_back(entry);
+        }
+    } else if (is_concrete(pattern.vendor_ids)) {
+        for (auto vendor_id : pattern.vendor_ids.ids) {
+            by_vendor_[vendor_id].push_back(entry);
+        }
+    } else {
+        fallback_.push_back(entry);
+    }
+}
+
+template<typename Fn>
+void ConfigIndex::for_each_candidate(const Device& device, Fn&& fn) const
+{
+    auto visit = [&](const auto& map, auto key) {
+        if (auto it = map.find(key); it != map.end()) {
+            rg::for_each(it->second, fn);
+        }
+    };
+
+    visit(by_vendor_device_, vendor_device_key(device.vendor_id(), device.device_id()));
+    visit(by_class_, device.class_id());
+    visit(by_vendor_, device.vendor_id());
+    rg::for_each(fallback_, fn);
+}
+
+const Config* ConfigIndex::find(const std::string& name) const
+{
+    auto it = by_name_.find(name);
+    return it != by_name_.end() ? &configs_[it->second] : nullptr;
+}
+
+std::vector<const Config*> ConfigIndex::match(const Device& device) const
+{
+    std::vector<std::uint32_t> hits;
+
+    for_each_candidate(device, [&](const Entry& entry) {
+        if (device.matches(configs_[entry.config].patterns()[entry.pattern])) {
+            hits.push_back(entry.config);
+        }
+    });
+
+    rg::sort(hits);
+    hits.erase(rg::unique(hits).begin(), hits.end());
+
+    return hits
+        | vw::transform([this](std::uint32_t idx) { return &configs_[idx]; })
+        | rg::to<std::vector<const Config*>>();
+}
+
+std::vector<const Config*> ConfigIndex::match(std::span<const Device> devices) const
+{
+    // Satisfied pattern flags per candidate config
+    std::unordered_map<std::uint32_t, std::vector<bool>> satisfied;
+
+    for (const auto& device : devices) {
+        for_each_candidate(device, [&](const Entry& entry) {
+            const auto& patterns = configs_[entry.config].patterns();
+            if (!device.matches(patterns[entry.pattern])) {
+                return;
+            }
+
+            auto& flags = satisfied[entry.config];
+            if (flags.empty()) {
+                flags.resize(patterns.size(), false);
+            }
+            flags[entry.pattern] = true;
+        });
+    }
+
+    auto matching = satisfied
+        | vw::filter([](const auto& kv) {
+            return std::all_of(kv.second.begin(), kv.second.end(), [](bool flag) { return flag; });
+        })
+        | vw::keys
+        | rg::to<std::vector<std::uint32_t>>();
+
+    rg::sort(matching);
+
+    return matching
+        | vw::transform([this](std::uint32_t idx) { return &configs_[idx]; })
+        | rg::to<std::vector<const Config*>>();
+}
+
+Result<ConfigIndex::Resolution, Error>
+ConfigIndex::resolve(const Config& config, const NameSet& installed) const
+{
+    // Concatenate memoized closures of the direct dependencies
+    std::vector<std::uint32_t> order;
+    std::vector<std::uint32_t> direct;
+
+    for (const auto& dep_name : config.dependencies()) {
+        auto it = by_name_.find(dep_name);
+        if (it == by_name_.end()) {
+            continue;
+        }
+
+        const auto& closure = closures_[it->second];
+        if (!closure || dep_name == config.name()) {
+            return std::unexpected(Error::DependencyCycle);
+        }
+
+        order.insert(order.end(), closure->begin(), closure->end());
+        order.push_back(it->second);
+        direct.push_back(it->second);
+    }
+
+    dedupe_stable(order, configs_.size());
+
+    // Walk dependents before dependencies, installed configs cut off their subtree
+    auto is_installed = [&](std::uint32_t idx) { return installed.contains(configs_[idx].name()); };
+
+    std::vector<bool> needed(configs_.size(), false);
+    for (auto idx : direct) {
+        needed[idx] = !is_installed(idx);
+    }
+    for (auto idx : order | vw::reverse) {
+        if (!needed[idx]) {
+            continue;
+        }
+        for (auto dep : dependencies_[idx]) {
+            needed[dep] = needed[dep] || !is_installed(dep);
+        }
+    }
+
+    Resolution resolution;
+    resolution.conflicts.insert(config.conflicts().begin(), config.conflicts().end());
+
+    for (auto idx : order) {
+        if (!needed[idx] || configs_[idx].name() == config.name()) {
+            continue;
+        }
+        const auto& dep = configs_[idx];
+        resolution.dependencies.push_back(&dep);
+        resolution.conflicts.insert(dep.conflicts().begin(), dep.conflicts().end());
+    }
+
+    return resolution;
+}
+
+} // namespace mcp::mhwd
@@ -0,0 +1,111 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Inverted index from hardware IDs to candidate driver configs.
+ * Replaces the config x device cross product used for matching.
+ */
+
+#pragma once
+
+#include "mhwd/Config.hpp"
+#include "mhwd/Device.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace mcp::mhwd {
+
+/**
+ * Immutable set of available configs with lookup tables for matching.
+ *
+ * Every hardware pattern is filed under its most selective key:
+ * vendor:device pairs first, then class IDs, then vendor IDs. Patterns
+ * that are wildcards on all three go to a small fallback list that is
+ * checked for every device. Lookups only narrow the candidates, the
+ * final decision is always made by Device::matches().
+ *
+ * Configs are kept sorted by priority (highest first), so all results
+ * come out in priority order.
+ *
+ * The dependency graph is resolved once at construction: every config
+ * gets its transitive dependency closure in install order, or is marked
+ * as part of (or depending on) a dependency cycle.
+ */
+class ConfigIndex {
+public:
+    using NameSet = std::unordered_set<std::string>;
+
+    /**
+     * Result of dependency resolution for a config about to be installed.
+     */
+    struct Resolution {
+        std::vector<const Config*> dependencies;  // Not installed yet, in install order
+        NameSet conflicts;                        // Config names conflicting with the whole set
+    };
+
+    explicit ConfigIndex(ConfigVector configs);
+
+    [[nodiscard]] const ConfigVector& configs() const { return configs_; }
+
+    /**
+     * Find config by name, nullptr if not available.
+     */
+    [[nodiscard]] const Config* find(const std::string& name) const;
+
+    /**
+     * Configs with at least one pattern matching the device.
+     */
+    [[nodiscard]] std::vector<const Config*> match(const Device& device) const;
+
+    /**
+     * Configs whose every pattern matches at least one of the devices.
+     */
+    [[nodiscard]] std::vector<const Config*> match(std::span<const Device> devices) const;
+
+    /**
+     * Dependencies to install together with config, skipping installed ones
+     * and anything only reachable through them.
+     * Fails with Error::DependencyCycle if the dependency graph loops.
+     */
+    [[nodiscard]] Result<Resolution, Error>
+    resolve(const Config& config, const NameSet& installed) const;
+
+private:
+    struct Entry {
+        std::uint32_t config;
+        std::uint32_t pattern;
+    };
+
+    template<typename Key>
+    using EntryMap = std::unordered_map<Key, std::vector<Entry>>;
+
+    void add_pattern(const HardwarePattern& pattern, Entry entry);
+    void build_dependency_graph();
+
+    template<typename Fn>
+    void for_each_candidate(const Device& device, Fn&& fn) const;
+
+    ConfigVector configs_;
+    std::unordered_map<std::string, std::uint32_t> by_name_;
+
+    EntryMap<std::uint32_t> by_vendor_device_;
+    EntryMap<HardwareId> by_class_;
+    EntryMap<HardwareId> by_vendor_;
+    std::vector<Entry> fallback_;
+
+    // Direct dependencies and memoized transitive closures (nullopt on cycle)
+    std::vector<std::vector<std::uint32_t>> dependencies_;
+    std::vector<std::optional<std::vector<std::uint32_t>>> closures_;
+};
+
+} // namespace mcp::mhwd
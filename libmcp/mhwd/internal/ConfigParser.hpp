@@ -0,0 +1,33 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * MHWDCONFIG parsing with shared include resolution, for bulk loaders.
+ */
+
+#pragma once
+
+#include "mhwd/Config.hpp"
+
+#include <filesystem>
+
+namespace mcp::mhwd {
+
+class IncludeCache;
+
+/**
+ * Parses configs, resolving ">filename" includes through a shared cache.
+ * Used when loading many configs that reference the same ID lists;
+ * Config::from_file parses a single config with a private cache.
+ */
+class ConfigParser {
+public:
+    [[nodiscard]] static Result<Config, ParseError>
+    parse(const std::filesystem::path& path, BusType type, IncludeCache& includes);
+};
+
+} // namespace mcp::mhwd
@@ -6,14 +6,23 @@
  */
 
 #include "mhwd/ConfigProvider.hpp"
+#include "mhwd/DeviceSnapshot.hpp"
+#include "ConfigIndex.hpp"
+#include "ConfigParser.hpp"
+#include "IncludeCache.hpp"
+#include "InstalledIndex.hpp"
+#include "DiskCache.hpp"
+#include "StartupTrace.hpp"
 
-#include <coro/when_all.hpp>
 #include <fmt/base.h>
 
 #include <algorithm>
 #include <filesystem>
+#include <format>
+#include <functional>
 #include <ranges>
 #include <unordered_set>
+#include <utility>
 
 /*
  * Driver configuration repository for queries and device matching.
@@ -32,17 +41,85 @@ auto extract_names = [](const auto& configs) {
     return configs | vw::transform(&Config::name) | rg::to<std::unordered_set<std::string>>();
 };
 
-auto build_name_map(const ConfigVector& configs) {
-    auto map = std::unordered_map<std::string, Config>{};
-    for (const auto& cfg : configs) {
-        map.emplace(cfg.name(), cfg);
+auto to_config_vector = [](const auto& configs) {
+    return configs | vw::transform([](const Config* config) { return *config; }) | rg::to<ConfigVector>();
+};
+
+// Installed configs conflicting with the config or its dependencies, either direction
+ConfigVector collect_conflicts(const InstalledIndex& installed,
+                               const Config& config,
+                               const ConfigIndex::Resolution& resolution)
+{
+    ConfigVector conflicts;
+    std::unordered_set<std::string> seen;
+
+    auto add = [&](const Config& other) {
+        if (seen.insert(other.name()).second) {
+            conflicts.push_back(other);
+        }
+    };
+
+    for (const auto& name : resolution.conflicts) {
+        if (const auto* other = installed.find(name)) {
+            add(*other);
+        }
     }
-    return map;
+
+    rg::for_each(installed.conflicting_with(config.name()), add);
+    for (const auto* dep : resolution.dependencies) {
+        rg::for_each(installed.conflicting_with(dep->name()), add);
+    }
+
+    return conflicts;
 }
 
-auto not_in_set(const std::unordered_set<std::string>& names) {
-    return [&names](const std::string& name) { return !names.contains(name); };
-};
+// Modification times of every file under dir, sorted by path
+std::vector<std::pair<fs::path, fs::file_time_type>> stamp_files(const fs::path& dir)
+{
+    std::vector<std::pair<fs::path, fs::file_time_type>> stamps;
+
+    std::error_code ec;
+    for (const auto& entry : fs::recursive_directory_iterator(dir, ec)) {
+        if (entry.is_regular_file(ec)) {
+            stamps.emplace_back(entry.path(), entry.last_write_time(ec));
+        }
+    }
+
+    rg::sort(stamps);
+    return stamps;
+}
+
+// Current modification times of the given files, missing ones stamped as min()
+std::vector<std::pair<fs::path, fs::file_time_type>>
+restamp(const std::vector<std::pair<fs::path, fs::file_time_type>>& stamps)
+{
+    std::vector<std::pair<fs::path, fs::file_time_type>> current;
+    current.reserve(stamps.size());
+
+    for (const auto& [path, mtime] : stamps) {
+        std::error_code ec;
+        const auto now = fs::last_write_time(path, ec);
+        current.emplace_back(path, ec ? fs::file_time_type::min() : now);
+    }
+
+    return current;
+}
+
+std::string format_stamps(const std::vector<std::pair<fs::path, fs::file_time_type>>& stamps)
+{
+    std::string text;
+    for (const auto& [path, mtime] : stamps) {
+        text += std::format("{} {}\n", path.string(), mtime.time_since_epoch().count());
+    }
+    return text;
+}
+
+// Included files found by the last parse of a bus database, stored under the
+// stamp of its config files so a fresh process can stamp them without parsing
+std::string includes_cache_name(BusType type)
+{
+    return std::format("mhwd-includes-{}", to_string(type));
+}
 
 }
 
@@ -51,172 +128,361 @@ ConfigProvider::ConfigProvider(const DeviceProvider& device_provider)
 {
 }
 
+ConfigProvider::~ConfigProvider() = default;
+
+void ConfigProvider::reload()
+{
+    std::lock_guard lock(cache_mutex_);
+
+    // Unchanged databases keep their index, and with it their generation
+    std::erase_if(available_cache_, [](const auto& kv) {
+        const auto& entry = kv.second;
+        return entry.stamps != stamp_files(config_dir(kv.first))
+            || entry.include_stamps != restamp(entry.include_stamps);
+    });
+
+    // Included files are not tracked by InstalledIndex, re-read everything
+    for (const auto& [type, entry] : installed_cache_) {
+        ++installed_generation_[type];
+    }
+    installed_cache_.clear();
+}
+
+ConfigProvider::IndexResult
+ConfigProvider::available_index(BusType type) const
+{
+    std::lock_guard lock(cache_mutex_);
+
+    if (auto it = available_cache_.find(type); it != available_cache_.end()) {
+        return it->second.index;
+    }
+
+    trace::Scope scope("ConfigProvider::load_configs {}", to_string(type));
+
+    auto stamps = stamp_files(config_dir(type));
+    auto loaded = load_configs_from_dir(config_dir(type), type);
+    if (!loaded) {
+        return std::unexpected(loaded.error());
+    }
+
+    std::string include_paths;
+    for (const auto& [path, mtime] : loaded->include_stamps) {
+        include_paths += path.string() + '\n';
+    }
+    cache::store(includes_cache_name(type), format_stamps(stamps), include_paths);
+
+    auto index = std::make_shared<const ConfigIndex>(std::move(loaded->configs));
+    available_cache_.emplace(type, AvailableEntry{index, std::move(stamps), std::move(loaded->include_stamps)});
+    ++available_generation_[type];
+    return index;
+}
+
 Task<ConfigVectorResult>
 ConfigProvider::get_available_configs(BusType type) const
 {
+    auto index = available_index(type);
+    if (!index) {
+        co_return std::unexpected(index.error());
+    }
+
+    co_return (*index)->configs();
+}
+
+template<typename Fn>
+auto ConfigProvider::with_installed(BusType type, Fn&& fn) const
+{
+    std::lock_guard lock(cache_mutex_);
+
+    auto& entry = installed_cache_[type];
+    if (!entry.index) {
+        entry.index = std::make_unique<InstalledIndex>(type);
+    }
+
+    // Installing or removing a config adds or removes a directory right
+    // under the bus database, so an unchanged mtime means nothing to rescan
+    std::error_code ec;
+    const auto mtime = fs::last_write_time(database_dir(type), ec);
+    if (ec || entry.mtime != mtime) {
+        if (entry.index->refresh(find_config_files(database_dir(type)))) {
+            ++installed_generation_[type];
+        }
+        entry.mtime = ec ? std::nullopt : std::optional{mtime};
+    }
 
-    const auto config_dir = (type == BusType::USB) ? c_usb_config_dir : c_pci_config_dir;
-    co_return load_configs_from_dir(config_dir, type);
+    return std::invoke(std::forward<Fn>(fn), std::as_const(*entry.index));
 }
 
 Task<ConfigVectorResult>
 ConfigProvider::get_installed_configs(BusType type) const
 {
+    if (!fs::exists(database_dir(type))) {
+        co_return std::unexpected(Error::InvalidPath);
+    }
+
+    co_return with_installed(type, [](const InstalledIndex& installed) {
+        return installed.configs();
+    });
+}
+
+std::uint64_t ConfigProvider::available_generation(BusType type) const
+{
+    // Make sure a dropped index is rebuilt and counted before reporting
+    (void)available_index(type);
 
-    const auto config_dir = (type == BusType::USB) ? c_usb_database_dir : c_pci_database_dir;
-    co_return load_configs_from_dir(config_dir, type);
+    std::lock_guard lock(cache_mutex_);
+    return available_generation_[type];
+}
+
+std::uint64_t ConfigProvider::installed_generation(BusType type) const
+{
+    return with_installed(type, [&](const InstalledIndex&) {
+        return installed_generation_[type];
+    });
+}
+
+std::string ConfigProvider::cache_stamp() const
+{
+    std::string stamp;
+
+    for (auto type : c_bus_types) {
+        const auto config_stamps = stamp_files(config_dir(type));
+        stamp += format_stamps(config_stamps);
+        stamp += format_stamps(stamp_files(database_dir(type)));
+
+        // Includes come from the loaded index or from the list the last parse of
+        // these config files stored, the database is only parsed when neither exists
+        std::optional<FileStamps> includes;
+        {
+            std::lock_guard lock(cache_mutex_);
+            if (auto it = available_cache_.find(type); it != available_cache_.end()) {
+                includes = it->second.include_stamps;
+            }
+        }
+
+        if (!includes) {
+            if (auto listed = cache::load(includes_cache_name(type), format_stamps(config_stamps))) {
+                includes.emplace();
+                for (auto line : vw::split(*listed, '\n')) {
+                    if (!line.empty()) {
+                        includes->emplace_back(std::string_view(line), fs::file_time_type::min());
+                    }
+                }
+            }
+        }
+
+        if (!includes && available_index(type)) {
+            std::lock_guard lock(cache_mutex_);
+            if (auto it = available_cache_.find(type); it != available_cache_.end()) {
+                includes = it->second.include_stamps;
+            }
+        }
+
+        if (includes) {
+            stamp += format_stamps(restamp(*includes));
+        }
+    }
+
+    return stamp + to_snapshot(device_provider_.all_devices());
 }
 
 Task<ConfigResult>
 ConfigProvider::find_config(const std::string& name, BusType type) const
 {
-    auto configs_result = co_await get_available_configs(type);
-    if (!configs_result) {
-        co_return std::unexpected(configs_result.error());
+    auto index = available_index(type);
+    if (!index) {
+        co_return std::unexpected(index.error());
     }
 
-    auto it = rg::find_if(*configs_result, [&name](const auto& config) {
-        return config.name() == name;
-    });
-
-    if (it != configs_result->end()) {
-        co_return *it;
+    if (const auto* config = (*index)->find(name)) {
+        co_return *config;
     }
 
     co_return std::unexpected(Error::NotFound);
 }
 
+Task<ConfigResult>
+ConfigProvider::find_installed_config(const std::string& name, BusType type) const
+{
+    co_return with_installed(type, [&name](const InstalledIndex& installed) -> ConfigResult {
+        if (const auto* config = installed.find(name)) {
+            return *config;
+        }
+        return std::unexpected(Error::NotFound);
+    });
+}
+
 Task<ConfigVector>
 ConfigProvider::find_matching_configs(BusType type) const
 {
-    const auto& devices = (type == BusType::USB)
-        ? device_provider_.usb_devices()
-        : device_provider_.pci_devices();
+    const auto devices = device_provider_.devices(type);
 
-    auto configs_result = co_await get_available_configs(type);
-    if (!configs_result) {
+    auto index = available_index(type);
+    if (!index) {
         co_return ConfigVector{};
     }
 
-    auto device_vec = devices | rg::to<DeviceVector>();
-    
-    auto matching = *configs_result
-        | vw::filter([&device_vec](const auto& config) {
-            return config.matches_devices(device_vec);
-        })
-        | rg::to<ConfigVector>();
-
-    rg::sort(matching, rg::greater{}, &Config::priority);
-
-    co_return matching;
+    // Index keeps configs in priority order
+    co_return to_config_vector((*index)->match(devices));
 }
 
 Task<ConfigVector>
 ConfigProvider::find_matching_configs_for_device(const Device& device) const
 {
-    auto configs_result = co_await get_available_configs(device.bus_type());
-    if (!configs_result) {
+    auto index = available_index(device.bus_type());
+    if (!index) {
         co_return ConfigVector{};
     }
 
-    auto matching = *configs_result
-        | vw::filter([&device](const auto& config) {
-            return rg::any_of(config.patterns(), [&device](const auto& pattern) {
-                return device.matches(pattern);
-            });
-        })
-        | rg::to<ConfigVector>();
-
-    rg::sort(matching, rg::greater{}, &Config::priority);
-
-    co_return matching;
+    co_return to_config_vector((*index)->match(device));
 }
 
-Task<ConfigVector>
-ConfigProvider::resolve_dependencies(const Config& config, BusType type) const
+Task<Result<AutoSelection, Error>>
+ConfigProvider::select_best(BusType type, DriverSelection drivers, std::optional<HardwareId> class_id) const
 {
-    auto [installed, available] = co_await coro::when_all(
-        get_installed_configs(type),
-        get_available_configs(type)
-    );
+    const auto devices = device_provider_.devices(type);
 
-    if (!installed.return_value() || !available.return_value()) {
-        co_return ConfigVector{};
+    auto index = available_index(type);
+    if (!index) {
+        co_return std::unexpected(index.error());
     }
 
-    const auto installed_names = extract_names(*installed.return_value());
-    const auto available_map = build_name_map(*available.return_value());
+    co_return with_installed(type, [&](const InstalledIndex& installed) {
+        // Configs whose every pattern is satisfied by the hardware as a whole
+        const auto eligible = (*index)->match(devices) | rg::to<std::unordered_set<const Config*>>();
+
+        AutoSelection selection;
+        auto planned = installed.names();
+        std::unordered_set<std::string> forbidden;
+
+        for (const auto& name : installed.names()) {
+            if (const auto* config = installed.find(name)) {
+                forbidden.insert(config->conflicts().begin(), config->conflicts().end());
+            }
+        }
 
-    ConfigVector result;
-    auto result_names = std::unordered_set<std::string>{};
+        auto acceptable = [&](const Config& config, const ConfigIndex::Resolution& resolution) {
+            auto clashes = [&](const Config& member) {
+                return forbidden.contains(member.name())
+                    || !installed.conflicting_with(member.name()).empty();
+            };
 
-    auto process_deps = [&](const auto& self, const Config& cfg) -> Task<void> {
-        auto unresolved_deps = cfg.dependencies()
-            | vw::filter(not_in_set(installed_names))
-            | vw::filter(not_in_set(result_names))
-            | rg::to<std::vector<std::string>>();
+            return !clashes(config)
+                && rg::none_of(resolution.dependencies, [&](const Config* dep) { return clashes(*dep); })
+                && rg::none_of(resolution.conflicts, [&](const std::string& name) { return planned.contains(name); });
+        };
 
-        for (const auto& dep_name : unresolved_deps) {
-            auto it = available_map.find(dep_name);
-            if (it == available_map.end()) {
+        for (const auto& device : devices) {
+            if (class_id && device.class_id() != *class_id) {
                 continue;
             }
 
-            co_await self(self, it->second);
+            auto candidates = (*index)->match(device)
+                | vw::filter([&](const Config* config) {
+                    return eligible.contains(config)
+                        && (drivers == DriverSelection::NonFree || config->is_free_driver());
+                })
+                | rg::to<std::vector<const Config*>>();
+
+            // Device already served by an installed or previously selected config
+            auto served = rg::find_if(candidates, [&](const Config* config) { return planned.contains(config->name()); });
+            if (served != candidates.end()) {
+                selection.best.push_back(**served);
+                continue;
+            }
 
-            if (result_names.insert(dep_name).second) {
-                result.push_back(it->second);
+            for (const auto* candidate : candidates) {
+                auto resolution = (*index)->resolve(*candidate, planned);
+                if (!resolution || !acceptable(*candidate, *resolution)) {
+                    continue;
+                }
+
+                for (const auto* dep : resolution->dependencies) {
+                    planned.insert(dep->name());
+                    selection.install.push_back(*dep);
+                }
+                planned.insert(candidate->name());
+                forbidden.insert(resolution->conflicts.begin(), resolution->conflicts.end());
+
+                selection.selected.push_back(*candidate);
+                selection.best.push_back(*candidate);
+                selection.install.push_back(*candidate);
+                break;
             }
         }
-    };
 
-    co_await process_deps(process_deps, config);
-    co_return result;
+        return Result<AutoSelection, Error>{std::move(selection)};
+    });
 }
 
-Task<ConfigVector>
-ConfigProvider::find_conflicts(const Config& config, BusType type) const
+Task<Result<InstallPlan, Error>>
+ConfigProvider::plan_install(const std::string& name, BusType type) const
 {
-    auto installed = co_await get_installed_configs(type);
-    if (!installed) {
-        co_return ConfigVector{};
+    auto index = available_index(type);
+    if (!index) {
+        co_return std::unexpected(index.error());
     }
 
-    auto dependencies = co_await resolve_dependencies(config, type);
-    auto all_to_install = dependencies;
-    all_to_install.push_back(config);
-
-    const auto installed_names = extract_names(*installed);
-
-    auto conflict_names = all_to_install
-        | vw::transform(&Config::conflicts)
-        | vw::join
-        | vw::filter([&installed_names](const auto& name) { return installed_names.contains(name); })
-        | rg::to<std::unordered_set<std::string>>();
+    const auto* config = (*index)->find(name);
+    if (!config) {
+        co_return std::unexpected(Error::NotFound);
+    }
 
-    auto conflicts = *installed
-        | vw::filter([&conflict_names](const Config& cfg) { return conflict_names.contains(cfg.name()); })
-        | rg::to<ConfigVector>();
+    co_return with_installed(type, [&](const InstalledIndex& installed) -> Result<InstallPlan, Error> {
+        auto resolution = (*index)->resolve(*config, installed.names());
+        if (!resolution) {
+            return std::unexpected(resolution.error());
+        }
 
-    co_return conflicts;
+        return InstallPlan{
+            .config = *config,
+            .installed = installed.contains(config->name()),
+            .dependencies = to_config_vector(resolution->dependencies),
+            .conflicts = collect_conflicts(installed, *config, *resolution),
+        };
+    });
 }
 
 Task<ConfigVector>
-ConfigProvider::find_required_by(const Config& config, BusType type) const
+ConfigProvider::resolve_dependencies(const Config& config, BusType type) const
 {
-    auto installed = co_await get_installed_configs(type);
-    if (!installed) {
+    auto index = available_index(type);
+    if (!index) {
         co_return ConfigVector{};
     }
 
-    auto required_by = *installed
-        | vw::filter([&config](const Config& cfg) { return cfg.depends_on(config.name()); })
-        | rg::to<ConfigVector>();
+    co_return with_installed(type, [&](const InstalledIndex& installed) {
+        auto resolution = (*index)->resolve(config, installed.names());
+        return resolution ? to_config_vector(resolution->dependencies) : ConfigVector{};
+    });
+}
+
+Task<ConfigVector>
+ConfigProvider::find_conflicts(const Config& config, BusType type) const
+{
+    auto index = available_index(type);
+
+    co_return with_installed(type, [&](const InstalledIndex& installed) {
+        if (!index) {
+            // Without the database only the config's own conflicts can be checked
+            ConfigIndex::Resolution own;
+            own.conflicts.insert(config.conflicts().begin(), config.conflicts().end());
+            return collect_conflicts(installed, config, own);
+        }
+
+        auto resolution = (*index)->resolve(config, installed.names());
+        return resolution ? collect_conflicts(installed, config, *resolution) : ConfigVector{};
+    });
+}
 
-    co_return required_by;
+Task<ConfigVector>
+ConfigProvider::find_required_by(const Config& config, BusType type) const
+{
+    co_return with_installed(type, [&config](const InstalledIndex& installed) {
+        return installed.required_by(config.name());
+    });
 }
 
-ConfigVectorResult
+Result<ConfigProvider::LoadedConfigs, Error>
 ConfigProvider::load_configs_from_dir(const fs::path& dir, BusType type) const
 {
     if (!fs::exists(dir)) {
@@ -224,16 +490,18 @@ ConfigProvider::load_configs_from_dir(const fs::path& dir, BusType type) const
     }
 
     auto config_files = find_config_files(dir);
-    ConfigVector configs;
+    LoadedConfigs loaded;
+    IncludeCache includes;
 
     for (const auto& file : config_files) {
-        auto config = Config::from_file(file, type);
+        auto config = ConfigParser::parse(file, type, includes);
         if (config) {
-            configs.push_back(std::move(*config));
+            loaded.configs.push_back(std::move(*config));
         }
     }
 
-    return configs;
+    loaded.include_stamps = includes.stamps();
+    return loaded;
 }
 
 std::vector<fs::path>
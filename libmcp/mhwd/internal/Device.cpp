@@ -6,8 +6,10 @@
 
 #include "mhwd/Device.hpp"
 #include "mhwd/Types.hpp"
+#include "NameCache.hpp"
 
 #include <algorithm>
+#include <format>
 #include <vector>
 
 /*
@@ -18,11 +20,6 @@ namespace mcp::mhwd {
 
 namespace {
 
-bool matches_id(const std::string& device_id, const std::string& pattern)
-{
-    return pattern == "*" || pattern == device_id;
-}
-
 DeviceCategory categorize_pci(unsigned int base_class)
 {
     switch (base_class) {
@@ -48,53 +45,69 @@ DeviceCategory categorize_usb(unsigned int base_class)
     }
 }
 
-DeviceCategory categorize_from_class_id(const std::string& class_id, BusType bus_type)
+DeviceCategory categorize_sdio(unsigned int base_class)
 {
-    if (class_id.length() < 2) {
-        return DeviceCategory::Unknown;
+    switch (base_class) {
+        case 0x07: return DeviceCategory::Network;  // WLAN
+        case 0x02:                                  // Bluetooth Type-A
+        case 0x09: return DeviceCategory::Network;  // Bluetooth AMP
+        default:   return DeviceCategory::Unknown;
     }
+}
+
+DeviceCategory categorize_from_class_id(HardwareId class_id, BusType bus_type)
+{
+    unsigned int base_class = (class_id >> 8) & 0xFF;
     
-    unsigned long class_code = std::stoul(class_id, nullptr, 16);
-    unsigned int base_class = (class_code >> 8) & 0xFF;
-    
-    return bus_type == BusType::PCI ? categorize_pci(base_class) : categorize_usb(base_class);
+    switch (bus_type) {
+        case BusType::PCI:         return categorize_pci(base_class);
+        case BusType::USB:         return categorize_usb(base_class);
+        case BusType::SDIO:        return categorize_sdio(base_class);
+        case BusType::HID:         return DeviceCategory::Input;
+        case BusType::Thunderbolt: return DeviceCategory::Unknown;
+    }
+    return DeviceCategory::Unknown;
 }
 
 }
 
 Device::Device(DeviceInfo info, BusType type)
-    : vendor_id_(std::move(info.vendor_id))
-    , device_id_(std::move(info.device_id))
-    , class_id_(std::move(info.class_id))
-    , vendor_name_(std::move(info.vendor_name))
-    , device_name_(std::move(info.device_name))
-    , class_name_(std::move(info.class_name))
+    : vendor_id_(info.vendor_id)
+    , device_id_(info.device_id)
+    , class_id_(info.class_id)
+    , bus_type_(type)
+    , category_(categorize_from_class_id(info.class_id, type))
+    , fallback_name_(info.device_name.empty() ? nullptr : NameCache::instance().intern(info.device_name))
     , sysfs_path_(std::move(info.sysfs_id))
     , bus_id_(std::move(info.sysfs_bus_id))
-    , bus_type_(type)
     , driver_(std::move(info.driver))
 {
 }
 
-DeviceCategory Device::category() const
+const std::string& Device::vendor_name() const
+{
+    return NameCache::instance().vendor(bus_type_, vendor_id_, class_id_);
+}
+
+const std::string& Device::device_name() const
+{
+    const auto& name = NameCache::instance().model(bus_type_, vendor_id_, device_id_, class_id_);
+    return (name.empty() && fallback_name_) ? *fallback_name_ : name;
+}
+
+const std::string& Device::class_name() const
 {
-    return categorize_from_class_id(class_id_, bus_type_);
+    return NameCache::instance().device_class(bus_type_, class_id_);
 }
 
 bool Device::matches(const HardwarePattern& pattern) const
 {
-    auto matches_any = [](const std::string& device_id, const std::vector<std::string>& patterns) {
-        return std::ranges::any_of(patterns, [&device_id](const std::string& p) { 
-            return matches_id(device_id, p); 
-        });
-    };
-
-    return matches_any(class_id_, pattern.class_ids) &&
-           !matches_any(class_id_, pattern.blacklisted_class_ids) &&
-           matches_any(vendor_id_, pattern.vendor_ids) &&
-           !matches_any(vendor_id_, pattern.blacklisted_vendor_ids) &&
-           matches_any(device_id_, pattern.device_ids) &&
-           !matches_any(device_id_, pattern.blacklisted_device_ids);
+    return pattern.class_ids.contains(class_id_) &&
+           !pattern.blacklisted_class_ids.contains(class_id_) &&
+           pattern.vendor_ids.contains(vendor_id_) &&
+           !pattern.blacklisted_vendor_ids.contains(vendor_id_) &&
+           pattern.device_ids.contains(device_id_) &&
+           !pattern.blacklisted_device_ids.contains(device_id_);
 }
 
 std::string_view to_string(DeviceCategory category)
@@ -111,4 +124,37 @@ std::string_view to_string(DeviceCategory category)
     return "Unknown"sv;
 }
 
+std::string_view to_string(BusType bus_type)
+{
+    using namespace std::string_view_literals;
+    switch (bus_type) {
+        case BusType::PCI:         return "PCI"sv;
+        case BusType::USB:         return "USB"sv;
+        case BusType::SDIO:        return "SDIO"sv;
+        case BusType::HID:         return "HID"sv;
+        case BusType::Thunderbolt: return "Thunderbolt"sv;
+    }
+    return "Unknown"sv;
+}
+
+std::optional<BusType> bus_type_from_string(std::string_view name)
+{
+    for (auto type : c_bus_types) {
+        if (to_string(type) == name) {
+            return type;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string to_string(const DeviceKey& key)
+{
+    return std::format("{}/{}/{:04x}:{:04x}", to_string(key.bus_type), key.bus_id, key.vendor_id, key.device_id);
+}
+
+std::string to_hex_string(HardwareId id)
+{
+    return std::format("{:04x}", id);
+}
+
 } // namespace mcp::mhwd
@@ -0,0 +1,54 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "mhwd/DeviceDiff.hpp"
+
+#include <iterator>
+#include <unordered_map>
+
+/*
+ * Keyed device set comparison.
+ */
+
+namespace mcp::mhwd {
+
+DeviceChangeVector diff_devices(std::span<const Device> before, std::span<const Device> after)
+{
+    std::unordered_map<DeviceKey, std::size_t> previous;
+    previous.reserve(before.size());
+    for (std::size_t idx = 0; idx < before.size(); ++idx) {
+        previous.emplace(before[idx].key(), idx);
+    }
+
+    std::vector<bool> kept(before.size(), false);
+    DeviceChangeVector updates;
+
+    for (const auto& device : after) {
+        auto it = previous.find(device.key());
+        if (it == previous.end()) {
+            updates.push_back({DeviceChange::Kind::Added, device});
+            continue;
+        }
+
+        kept[it->second] = true;
+        if (before[it->second] != device) {
+            updates.push_back({DeviceChange::Kind::Changed, device});
+        }
+    }
+
+    DeviceChangeVector changes;
+    for (std::size_t idx = 0; idx < before.size(); ++idx) {
+        if (!kept[idx]) {
+            changes.push_back({DeviceChange::Kind::Removed, before[idx]});
+        }
+    }
+    changes.insert(changes.end(), std::make_move_iterator(updates.begin()), std::make_move_iterator(updates.end()));
+
+    return changes;
+}
+
+} // namespace mcp::mhwd
@@ -6,33 +6,226 @@
  */
 
 #include "mhwd/DeviceProvider.hpp"
-#include "udev/PciDeviceScanner.hpp"
-#include "udev/UsbDeviceScanner.hpp"
+#include "mhwd/ConfigProvider.hpp"
+#include "StartupTrace.hpp"
+#include "udev/DeviceMonitor.hpp"
+#include "udev/Scanners.hpp"
+#include "sysfs/PciSysfsScanner.hpp"
+#include "sysfs/UsbSysfsScanner.hpp"
+
+#include <coro/when_all.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
+#include <string_view>
 
 /*
  * Hardware detection coordinator.
  * Delegates actual scanning to DeviceScanner specializations.
  */
 
+namespace rg = std::ranges;
+
 namespace mcp::mhwd {
 
+namespace {
+
+// udev property lookups add up on busy buses, keep them off the caller's thread
+Task<DeviceVector> scan_bus(BusType type, const ScanOptions& options)
+{
+    co_await io_scheduler().schedule();
+
+    // Only PCI and USB have a sysfs fast path
+    if (options.backend == ScanBackend::Sysfs) {
+        if (type == BusType::PCI) {
+            co_return PciSysfsScanner::scan(options.sysfs_root);
+        }
+        if (type == BusType::USB) {
+            co_return UsbSysfsScanner::scan(options.sysfs_root);
+        }
+    }
+    co_return scan_udev(type);
+}
+
+std::size_t bus_index(BusType type)
+{
+    return static_cast<std::size_t>(type);
+}
+
+} // namespace
+
+ScanOptions ScanOptions::from_environment()
+{
+    ScanOptions options;
+
+    if (const char* backend = std::getenv("MCP_MHWD_SCAN_BACKEND")) {
+        options.backend = std::string_view(backend) == "sysfs" ? ScanBackend::Sysfs : ScanBackend::Udev;
+    }
+    if (const char* root = std::getenv("MCP_MHWD_SYSFS_ROOT"); root && *root) {
+        options.sysfs_root = root;
+    }
+
+    return options;
+}
+
+DeviceProvider::DeviceProvider(ScanOptions options)
+    : options_(std::move(options))
+{
+    // PCI and USB are always scanned, other buses only when there are configs for them
+    for (auto type : c_bus_types) {
+        std::error_code ec;
+        enabled_[bus_index(type)] = type == BusType::PCI
+                                 || type == BusType::USB
+                                 || std::filesystem::exists(config_dir(type), ec);
+    }
+}
+
+DeviceProvider::DeviceProvider(const DeviceVector& snapshot)
+    : snapshot_(true)
+{
+    enabled_[bus_index(BusType::PCI)] = true;
+    enabled_[bus_index(BusType::USB)] = true;
+
+    for (const auto& device : snapshot) {
+        devices_[bus_index(device.bus_type())].push_back(device);
+        enabled_[bus_index(device.bus_type())] = true;
+    }
+}
+
+bool DeviceProvider::is_enabled(BusType type) const
+{
+    return enabled_[bus_index(type)];
+}
+
+DeviceProvider::~DeviceProvider()
+{
+    stop_monitoring();
+}
+
+DeviceVector DeviceProvider::devices(BusType type) const
+{
+    std::lock_guard lock(mutex_);
+    return devices_[bus_index(type)];
+}
+
 DeviceVector DeviceProvider::all_devices() const
 {
+    std::lock_guard lock(mutex_);
+
+    std::size_t total = 0;
+    for (const auto& devices : devices_) {
+        total += devices.size();
+    }
+
     DeviceVector all;
-    all.reserve(pci_devices_.size() + usb_devices_.size());
+    all.reserve(total);
 
-    all.insert(all.end(), pci_devices_.begin(), pci_devices_.end());
-    all.insert(all.end(), usb_devices_.begin(), usb_devices_.end());
+    for (const auto& devices : devices_) {
+        all.insert(all.end(), devices.begin(), devices.end());
+    }
 
     return all;
 }
 
 Task<void> DeviceProvider::scan()
 {
-    // udev scanning is fast local I/O, wrapped in coroutine for API consistency
-    pci_devices_ = PciDeviceScanner::scan();
-    usb_devices_ = UsbDeviceScanner::scan();
-    co_return;
+    if (snapshot_) {
+        co_return;
+    }
+
+    trace::Scope scope("DeviceProvider::scan");
+
+    std::vector<BusType> buses;
+    std::vector<Task<DeviceVector>> tasks;
+
+    for (auto type : c_bus_types) {
+        if (is_enabled(type)) {
+            buses.push_back(type);
+            tasks.push_back(scan_bus(type, options_));
+        }
+    }
+
+    auto results = co_await coro::when_all(std::move(tasks));
+
+    DeviceChangeVector changes;
+
+    {
+        // Readers see either the old or the new device set, never a mix
+        std::lock_guard lock(mutex_);
+        for (std::size_t i = 0; i < buses.size(); ++i) {
+            auto& devices = devices_[bus_index(buses[i])];
+            auto scanned = std::move(results[i].return_value());
+
+            rg::move(diff_devices(devices, scanned), std::back_inserter(changes));
+            devices = std::move(scanned);
+        }
+    }
+
+    if (!changes.empty()) {
+        signal_devices_changed.emit(changes);
+    }
+}
+
+bool DeviceProvider::start_monitoring()
+{
+    if (snapshot_) {
+        return false;
+    }
+
+    if (!monitor_) {
+        monitor_ = std::make_unique<DeviceMonitor>([this](std::vector<DeviceEvent> events) {
+            apply_events(std::move(events));
+        });
+    }
+    return monitor_->start();
+}
+
+void DeviceProvider::stop_monitoring()
+{
+    if (monitor_) {
+        monitor_->stop();
+    }
+}
+
+void DeviceProvider::apply_events(std::vector<DeviceEvent> events)
+{
+    DeviceChangeVector changes;
+
+    {
+        std::lock_guard lock(mutex_);
+
+        for (auto& event : events) {
+            if (!is_enabled(event.bus_type)) {
+                continue;
+            }
+
+            auto& devices = devices_[bus_index(event.bus_type)];
+            auto it = rg::find(devices, event.syspath, &Device::sysfs_path);
+
+            if (event.action == DeviceEvent::Action::Remove || !event.device) {
+                if (it != devices.end()) {
+                    changes.push_back({DeviceChange::Kind::Removed, std::move(*it)});
+                    devices.erase(it);
+                }
+                continue;
+            }
+
+            if (it == devices.end()) {
+                devices.push_back(*event.device);
+                changes.push_back({DeviceChange::Kind::Added, std::move(*event.device)});
+            } else if (*it != *event.device) {
+                *it = *event.device;
+                changes.push_back({DeviceChange::Kind::Changed, std::move(*event.device)});
+            }
+        }
+    }
+
+    // Emit outside the lock so subscribers may query the provider
+    if (!changes.empty()) {
+        signal_devices_changed.emit(changes);
+    }
 }
 
 } // namespace mcp::mhwd
@@ -0,0 +1,171 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "mhwd/DeviceSnapshot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+
+/*
+ * Snapshot text serialization.
+ */
+
+namespace mcp::mhwd {
+
+namespace {
+
+constexpr std::size_t c_field_count = 8;
+
+std::optional<HardwareId> parse_id(std::string_view field)
+{
+    HardwareId id = 0;
+    auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), id, 16);
+    if (ec != std::errc{} || ptr != field.data() + field.size()) {
+        return std::nullopt;
+    }
+    return id;
+}
+
+// Tabs and newlines would break the line format
+std::string sanitize(std::string_view value)
+{
+    std::string result(value);
+    std::ranges::replace_if(result, [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+    return result;
+}
+
+std::optional<Device> parse_line(std::string_view line)
+{
+    std::array<std::string_view, c_field_count> fields;
+
+    std::size_t count = 0;
+    while (count < c_field_count - 1) {
+        auto tab = line.find('\t');
+        if (tab == std::string_view::npos) {
+            return std::nullopt;
+        }
+        fields[count++] = line.substr(0, tab);
+        line.remove_prefix(tab + 1);
+    }
+    fields[count] = line;   // Name is last and may contain anything but tabs
+
+    auto bus = bus_type_from_string(fields[0]);
+    auto class_id = parse_id(fields[1]);
+    auto vendor_id = parse_id(fields[2]);
+    auto device_id = parse_id(fields[3]);
+    if (!bus || !class_id || !vendor_id || !device_id) {
+        return std::nullopt;
+    }
+
+    return Device(DeviceInfo{
+        .class_id = *class_id,
+        .vendor_id = *vendor_id,
+        .device_id = *device_id,
+        .device_name = std::string(fields[7]),
+        .sysfs_bus_id = std::string(fields[4]),
+        .sysfs_id = std::string(fields[5]),
+        .driver = std::string(fields[6]),
+    }, *bus);
+}
+
+} // namespace
+
+std::string to_snapshot(const DeviceVector& devices)
+{
+    std::string text(c_snapshot_header);
+    text += '\n';
+
+    for (const auto& device : devices) {
+        std::format_to(std::back_inserter(text), "{}\t{:04x}\t{:04x}\t{:04x}\t{}\t{}\t{}\t{}\n",
+                       to_string(device.bus_type()),
+                       device.class_id(),
+                       device.vendor_id(),
+                       device.device_id(),
+                       sanitize(device.bus_id()),
+                       sanitize(device.sysfs_path()),
+                       sanitize(device.driver()),
+                       sanitize(device.device_name()));
+    }
+
+    return text;
+}
+
+Result<DeviceVector, Error> parse_snapshot(std::string_view text)
+{
+    DeviceVector devices;
+    bool header = false;
+
+    while (!text.empty()) {
+        auto newline = text.find('\n');
+        auto line = text.substr(0, newline);
+        text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        // The first non-empty line names the format, an unknown version is not guessed at
+        if (!header) {
+            if (line.empty()) {
+                continue;
+            }
+            if (line != c_snapshot_header) {
+                return std::unexpected(Error::ParseError);
+            }
+            header = true;
+            continue;
+        }
+
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        auto device = parse_line(line);
+        if (!device) {
+            return std::unexpected(Error::ParseError);
+        }
+        devices.push_back(std::move(*device));
+    }
+
+    if (!header) {
+        return std::unexpected(Error::ParseError);
+    }
+    return devices;
+}
+
+Result<DeviceVector, Error> load_snapshot(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::unexpected(Error::InvalidPath);
+    }
+
+    std::ostringstream content;
+    content << file.rdbuf();
+    return parse_snapshot(content.str());
+}
+
+Result<void, Error> save_snapshot(const std::filesystem::path& path, const DeviceVector& devices)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return std::unexpected(Error::InvalidPath);
+    }
+
+    file << to_snapshot(devices);
+    if (!file) {
+        return std::unexpected(Error::DatabaseError);
+    }
+    return {};
+}
+
+} // namespace mcp::mhwd
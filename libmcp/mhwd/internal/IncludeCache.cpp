@@ -0,0 +1,90 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "IncludeCache.hpp"
+#include "StringUtils.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+namespace mcp::mhwd {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using namespace string_utils;
+
+IncludeFile read_include_file(const fs::path& path)
+{
+    IncludeFile result;
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return result;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        const auto comment_pos = line.find('#');
+        if (comment_pos != std::string::npos) {
+            line = line.substr(0, comment_pos);
+        }
+
+        line = trim(line);
+        if (!line.empty()) {
+            result.text += " " + line;
+        }
+    }
+
+    result.text = trim(result.text);
+    result.tokens = split_values(result.text);
+    return result;
+}
+
+} // namespace
+
+std::shared_ptr<const IncludeFile>
+IncludeCache::get(const fs::path& file_path, const fs::path& base_path)
+{
+    const fs::path full_path = file_path.is_absolute() ? file_path : base_path / file_path;
+
+    std::error_code ec;
+    auto canonical = fs::canonical(full_path, ec);
+    if (ec) {
+        // Still stamped, so creating the file later invalidates what was parsed without it
+        auto file = std::make_shared<const IncludeFile>();
+        entries_.insert_or_assign(full_path.lexically_normal().string(), Entry{fs::file_time_type::min(), file});
+        return file;
+    }
+
+    auto mtime = fs::last_write_time(canonical, ec);
+    auto key = canonical.string();
+
+    if (auto it = entries_.find(key); it != entries_.end() && !ec && it->second.mtime == mtime) {
+        return it->second.file;
+    }
+
+    auto file = std::make_shared<const IncludeFile>(read_include_file(canonical));
+    entries_.insert_or_assign(std::move(key), Entry{mtime, file});
+    return file;
+}
+
+std::vector<std::pair<fs::path, fs::file_time_type>> IncludeCache::stamps() const
+{
+    std::vector<std::pair<fs::path, fs::file_time_type>> result;
+    result.reserve(entries_.size());
+
+    for (const auto& [path, entry] : entries_) {
+        result.emplace_back(path, entry.mtime);
+    }
+
+    std::ranges::sort(result);
+    return result;
+}
+
+} // namespace mcp::mhwd
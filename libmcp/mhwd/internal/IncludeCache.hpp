@@ -0,0 +1,63 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Content cache for files referenced from MHWDCONFIG via ">filename".
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mcp::mhwd {
+
+/**
+ * Comment-stripped contents of an included file.
+ */
+struct IncludeFile {
+    std::string text;                 // Lines joined with single spaces
+    std::vector<std::string> tokens;  // Lowercased space-separated values
+};
+
+/**
+ * Reads and tokenizes included files once per config load.
+ *
+ * Upstream configs share large device ID lists between several
+ * MHWDCONFIGs. Entries are keyed by canonical path and invalidated
+ * when the file modification time changes.
+ */
+class IncludeCache {
+public:
+    /**
+     * Get contents of an included file, resolved against base_path.
+     * Unreadable files yield an empty entry.
+     */
+    [[nodiscard]] std::shared_ptr<const IncludeFile>
+    get(const std::filesystem::path& file_path, const std::filesystem::path& base_path);
+
+    /**
+     * Canonical path and modification time of every file read so far,
+     * sorted by path. Missing files are listed with file_time_type::min().
+     */
+    [[nodiscard]] std::vector<std::pair<std::filesystem::path, std::filesystem::file_time_type>>
+    stamps() const;
+
+private:
+    struct Entry {
+        std::filesystem::file_time_type mtime;
+        std::shared_ptr<const IncludeFile> file;
+    };
+
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+} // namespace mcp::mhwd
@@ -0,0 +1,173 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "InstalledIndex.hpp"
+#include "ConfigParser.hpp"
+#include "IncludeCache.hpp"
+
+#include <algorithm>
+
+/*
+ * Stat-driven refresh and adjacency bookkeeping for installed configs.
+ */
+
+namespace rg = std::ranges;
+
+namespace mcp::mhwd {
+
+namespace fs = std::filesystem;
+
+InstalledIndex::InstalledIndex(BusType type)
+    : type_(type)
+{
+}
+
+bool InstalledIndex::refresh(const std::vector<fs::path>& config_files)
+{
+    bool changed = false;
+    IncludeCache includes;
+    std::unordered_set<std::string> seen;
+
+    for (const auto& path : config_files) {
+        auto file = path.string();
+        seen.insert(file);
+
+        std::error_code ec;
+        auto mtime = fs::last_write_time(path, ec);
+
+        if (auto it = by_file_.find(file); it != by_file_.end()) {
+            if (!ec && it->second.mtime == mtime) {
+                continue;
+            }
+            remove(file);
+            changed = true;
+        }
+
+        if (auto config = ConfigParser::parse(path, type_, includes)) {
+            add(file, Entry{std::move(*config), mtime});
+            changed = true;
+        }
+    }
+
+    std::vector<std::string> gone;
+    for (const auto& [file, entry] : by_file_) {
+        if (!seen.contains(file)) {
+            gone.push_back(file);
+        }
+    }
+    for (const auto& file : gone) {
+        remove(file);
+        changed = true;
+    }
+
+    return changed;
+}
+
+void InstalledIndex::add(const std::string& file, Entry entry)
+{
+    const auto& name = entry.config.name();
+
+    for (const auto& dep : entry.config.dependencies()) {
+        required_by_[dep].insert(name);
+    }
+    for (const auto& conflict : entry.config.conflicts()) {
+        conflicting_with_[conflict].insert(name);
+    }
+
+    names_.insert(name);
+    file_by_name_.insert_or_assign(name, file);
+    by_file_.insert_or_assign(file, std::move(entry));
+}
+
+void InstalledIndex::remove(const std::string& file)
+{
+    auto it = by_file_.find(file);
+    if (it == by_file_.end()) {
+        return;
+    }
+
+    const auto& config = it->second.config;
+    const auto name = config.name();
+
+    for (const auto& dep : config.dependencies()) {
+        required_by_[dep].erase(name);
+    }
+    for (const auto& conflict : config.conflicts()) {
+        conflicting_with_[conflict].erase(name);
+    }
+
+    by_file_.erase(it);
+
+    // Another file may install a config under the same name, it takes over
+    // the name and its adjacency instead of the name disappearing with this one
+    auto other = rg::find_if(by_file_, [&name](const auto& item) {
+        return item.second.config.name() == name;
+    });
+    if (other == by_file_.end()) {
+        names_.erase(name);
+        file_by_name_.erase(name);
+        return;
+    }
+
+    for (const auto& dep : other->second.config.dependencies()) {
+        required_by_[dep].insert(name);
+    }
+    for (const auto& conflict : other->second.config.conflicts()) {
+        conflicting_with_[conflict].insert(name);
+    }
+    file_by_name_.insert_or_assign(name, other->first);
+}
+
+const Config* InstalledIndex::find(const std::string& name) const
+{
+    auto it = file_by_name_.find(name);
+    if (it == file_by_name_.end()) {
+        return nullptr;
+    }
+    return &by_file_.at(it->second).config;
+}
+
+ConfigVector InstalledIndex::configs() const
+{
+    ConfigVector result;
+    result.reserve(by_file_.size());
+    for (const auto& [file, entry] : by_file_) {
+        result.push_back(entry.config);
+    }
+    rg::sort(result, {}, &Config::name);
+    return result;
+}
+
+ConfigVector InstalledIndex::collect(const std::unordered_map<std::string, NameSet>& adjacency,
+                                     const std::string& name) const
+{
+    ConfigVector result;
+
+    auto it = adjacency.find(name);
+    if (it == adjacency.end()) {
+        return result;
+    }
+
+    for (const auto& other : it->second) {
+        if (const auto* config = find(other)) {
+            result.push_back(*config);
+        }
+    }
+    return result;
+}
+
+ConfigVector InstalledIndex::required_by(const std::string& name) const
+{
+    return collect(required_by_, name);
+}
+
+ConfigVector InstalledIndex::conflicting_with(const std::string& name) const
+{
+    return collect(conflicting_with_, name);
+}
+
+} // namespace mcp::mhwd
@@ -0,0 +1,83 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Installed driver configs with reverse-dependency and conflict adjacency.
+ */
+
+#pragma once
+
+#include "mhwd/Config.hpp"
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace mcp::mhwd {
+
+/**
+ * Incrementally maintained view of /var/lib/mhwd/local/<bus>.
+ *
+ * refresh() re-stats the config files and only re-parses added or
+ * modified ones, so validation queries (is installed, required by,
+ * conflicting with) are hash lookups instead of scans over all
+ * installed configs.
+ */
+class InstalledIndex {
+public:
+    using NameSet = std::unordered_set<std::string>;
+
+    explicit InstalledIndex(BusType type);
+
+    /**
+     * Apply added, modified and removed config files.
+     * Returns true if the installed set changed.
+     */
+    bool refresh(const std::vector<std::filesystem::path>& config_files);
+
+    [[nodiscard]] const NameSet& names() const { return names_; }
+    [[nodiscard]] bool contains(const std::string& name) const { return names_.contains(name); }
+
+    [[nodiscard]] const Config* find(const std::string& name) const;
+    [[nodiscard]] ConfigVector configs() const;
+
+    /**
+     * Installed configs listing name in MHWDDEPENDS.
+     */
+    [[nodiscard]] ConfigVector required_by(const std::string& name) const;
+
+    /**
+     * Installed configs listing name in MHWDCONFLICTS.
+     * The opposite direction is covered by the caller's own conflict list.
+     */
+    [[nodiscard]] ConfigVector conflicting_with(const std::string& name) const;
+
+private:
+    struct Entry {
+        Config config;
+        std::filesystem::file_time_type mtime;
+    };
+
+    void add(const std::string& file, Entry entry);
+    void remove(const std::string& file);
+
+    [[nodiscard]] ConfigVector collect(const std::unordered_map<std::string, NameSet>& adjacency,
+                                       const std::string& name) const;
+
+    BusType type_;
+
+    std::unordered_map<std::string, Entry> by_file_;
+    std::unordered_map<std::string, std::string> file_by_name_;
+    NameSet names_;
+
+    std::unordered_map<std::string, NameSet> required_by_;
+    std::unordered_map<std::string, NameSet> conflicting_with_;
+};
+
+} // namespace mcp::mhwd
@@ -0,0 +1,143 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "NameCache.hpp"
+
+#include <format>
+#include <mutex>
+
+namespace mcp::mhwd {
+
+NameCache& NameCache::instance()
+{
+    static NameCache cache;
+    return cache;
+}
+
+namespace {
+
+// HID_ID transport bus for USB, whose IDs resolve through the USB hwdb
+constexpr HardwareId c_hid_bus_usb = 0x0003;
+
+} // namespace
+
+std::uint64_t NameCache::make_key(BusType bus, Kind kind, HardwareId first, HardwareId second, HardwareId third)
+{
+    return (std::uint64_t{static_cast<std::uint8_t>(bus)} << 56)
+         | (std::uint64_t{static_cast<std::uint8_t>(kind)} << 48)
+         | (std::uint64_t{first} << 32)
+         | (std::uint64_t{second} << 16)
+         | third;
+}
+
+template<typename MakeModalias>
+const std::string& NameCache::lookup(std::uint64_t key, MakeModalias&& make_modalias, std::string_view property)
+{
+    {
+        std::shared_lock lock(mutex_);
+        if (auto it = names_.find(key); it != names_.end()) {
+            return *it->second;
+        }
+    }
+
+    std::unique_lock lock(mutex_);
+    if (auto it = names_.find(key); it != names_.end()) {
+        return *it->second;
+    }
+
+    if (!udev_) {
+        udev_.reset(udev_new());
+        hwdb_.reset(udev_ ? udev_hwdb_new(udev_.get()) : nullptr);
+    }
+
+    // Buses without hwdb entries produce an empty modalias and an empty name
+    const std::string modalias = make_modalias();
+    std::string name = (hwdb_ && !modalias.empty()) ? udev::hwdb_property(hwdb_.get(), modalias, property) : std::string{};
+    auto handle = intern_locked(name);
+    names_.emplace(key, handle);
+    return *handle;
+}
+
+const std::string& NameCache::vendor(BusType bus, HardwareId vendor_id, HardwareId class_id)
+{
+    const HardwareId scope = bus == BusType::HID ? class_id : 0;
+
+    return lookup(make_key(bus, Kind::Vendor, vendor_id, scope), [&]() -> std::string {
+        switch (bus) {
+            case BusType::PCI:  return std::format("pci:v{:08X}", vendor_id);
+            case BusType::USB:  return std::format("usb:v{:04X}", vendor_id);
+            case BusType::SDIO: return std::format("sdio:c00v{:04X}", vendor_id);
+            case BusType::HID:  return class_id == c_hid_bus_usb ? std::format("usb:v{:04X}", vendor_id) : "";
+            default:            return {};
+        }
+    }, "ID_VENDOR_FROM_DATABASE");
+}
+
+const std::string& NameCache::model(BusType bus, HardwareId vendor_id, HardwareId device_id, HardwareId class_id)
+{
+    const HardwareId scope = bus == BusType::HID ? class_id : 0;
+
+    return lookup(make_key(bus, Kind::Model, vendor_id, device_id, scope), [&]() -> std::string {
+        switch (bus) {
+            case BusType::PCI:  return std::format("pci:v{:08X}d{:08X}", vendor_id, device_id);
+            case BusType::USB:  return std::format("usb:v{:04X}p{:04X}", vendor_id, device_id);
+            case BusType::SDIO: return std::format("sdio:c00v{:04X}d{:04X}", vendor_id, device_id);
+            case BusType::HID:
+                return class_id == c_hid_bus_usb ? std::format("usb:v{:04X}p{:04X}", vendor_id, device_id) : "";
+            default:            return {};
+        }
+    }, "ID_MODEL_FROM_DATABASE");
+}
+
+const std::string& NameCache::device_class(BusType bus, HardwareId class_id)
+{
+    // Class entries are keyed by full modalias patterns ("pci:v*d*sv*sd*bc03*")
+    const unsigned base = class_id >> 8;
+    const unsigned sub = class_id & 0xFF;
+
+    auto property = [bus]() -> std::string_view {
+        switch (bus) {
+            case BusType::PCI:  return "ID_PCI_CLASS_FROM_DATABASE";
+            case BusType::USB:  return "ID_USB_CLASS_FROM_DATABASE";
+            case BusType::SDIO: return "ID_SDIO_CLASS_FROM_DATABASE";
+            default:            return {};
+        }
+    };
+
+    return lookup(make_key(bus, Kind::Class, class_id), [&]() -> std::string {
+        switch (bus) {
+            case BusType::PCI:
+                return std::format("pci:v00000000d00000000sv00000000sd00000000bc{:02X}sc{:02X}i00", base, sub);
+            case BusType::USB:
+                return std::format("usb:v0000p0000d0000dc{:02X}dsc{:02X}dp00", base, sub);
+            case BusType::SDIO:
+                return std::format("sdio:c{:02X}v0000d0000", base);
+            default:
+                return {};
+        }
+    }, property());
+}
+
+NameHandle NameCache::intern(std::string_view name)
+{
+    {
+        std::shared_lock lock(mutex_);
+        if (auto it = strings_.find(std::string(name)); it != strings_.end()) {
+            return &*it;
+        }
+    }
+
+    std::unique_lock lock(mutex_);
+    return intern_locked(name);
+}
+
+NameHandle NameCache::intern_locked(std::string_view name)
+{
+    return &*strings_.emplace(name).first;
+}
+
+} // namespace mcp::mhwd
@@ -0,0 +1,69 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Process-wide cache of hwdb vendor, model and class names.
+ */
+
+#pragma once
+
+#include "mhwd/Types.hpp"
+#include "udev/UdevUtils.hpp"
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace mcp::mhwd {
+
+/**
+ * Interned hardware names, resolved from hwdb on first use.
+ *
+ * Names are keyed by numeric IDs, so all devices of one vendor share a
+ * single string and a single hwdb query. Returned references stay valid
+ * for the lifetime of the process.
+ */
+class NameCache {
+public:
+    static NameCache& instance();
+
+    // class_id only matters for HID, where it selects the transport's ID namespace
+    [[nodiscard]] const std::string& vendor(BusType bus, HardwareId vendor_id, HardwareId class_id);
+    [[nodiscard]] const std::string& model(BusType bus, HardwareId vendor_id, HardwareId device_id, HardwareId class_id);
+    [[nodiscard]] const std::string& device_class(BusType bus, HardwareId class_id);
+
+    /**
+     * Intern an arbitrary name (e.g. a USB descriptor string).
+     */
+    [[nodiscard]] NameHandle intern(std::string_view name);
+
+private:
+    enum class Kind : std::uint8_t { Vendor, Model, Class };
+
+    NameCache() = default;
+
+    template<typename MakeModalias>
+    const std::string& lookup(std::uint64_t key, MakeModalias&& make_modalias, std::string_view property);
+
+    NameHandle intern_locked(std::string_view name);
+
+    static std::uint64_t make_key(BusType bus, Kind kind, HardwareId first,
+                                  HardwareId second = 0, HardwareId third = 0);
+
+    std::shared_mutex mutex_;
+    std::unordered_map<std::uint64_t, NameHandle> names_;
+    std::unordered_set<std::string> strings_;   // Node based, element addresses are stable
+
+    // Opened on the first cache miss
+    udev::UdevPtr udev_;
+    udev::UdevHwdbPtr hwdb_;
+};
+
+} // namespace mcp::mhwd
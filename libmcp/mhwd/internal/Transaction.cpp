@@ -12,6 +12,7 @@
 #include "mhwd/Transaction.hpp"
 
 #include <algorithm>
+#include <ranges>
 
 namespace rg = std::ranges;
 
@@ -23,62 +24,71 @@ build_install(
     const std::string& config_name,
     BusType type)
 {
-    auto config_result = co_await provider.find_config(config_name, type);
-    if (!config_result) {
-        co_return std::unexpected(Error::NotFound);
+    auto plan = co_await provider.plan_install(config_name, type);
+    if (!plan) {
+        co_return std::unexpected(plan.error() == Error::DependencyCycle
+            ? Error::DependencyCycle
+            : Error::NotFound);
     }
 
-    const auto& config = *config_result;
-
-    auto installed = co_await provider.get_installed_configs(type);
-    if (installed) {
-        auto is_installed = rg::any_of(*installed, [&config](const auto& inst) {
-            return inst.name() == config.name();
-        });
-        
-        if (is_installed) {
-            co_return std::unexpected(Error::AlreadyInstalled);
-        }
+    if (plan->installed) {
+        co_return std::unexpected(Error::AlreadyInstalled);
     }
 
-    auto conflicts = co_await provider.find_conflicts(config, type);
-    if (!conflicts.empty()) {
+    if (!plan->conflicts.empty()) {
         co_return std::unexpected(Error::HasConflicts);
     }
 
-    auto dependencies = co_await provider.resolve_dependencies(config, type);
-
     std::vector<std::string> packages;
-    for (const auto& dep : dependencies) {
+    for (const auto& dep : plan->dependencies) {
         packages.push_back(dep.name());
     }
-    packages.push_back(config.name());
+    packages.push_back(plan->config.name());
 
     co_return agent::make_install(std::move(packages));
 }
 
 Task<CommandResult>
-build_remove(
+build_auto_install(
     const ConfigProvider& provider,
-    const std::string& config_name,
-    BusType type)
+    BusType type,
+    DriverSelection drivers,
+    std::optional<HardwareId> class_id)
 {
-    auto installed = co_await provider.get_installed_configs(type);
-    if (!installed) {
-        co_return std::unexpected(Error::InvalidOperation);
+    auto selection = co_await provider.select_best(type, drivers, class_id);
+    if (!selection) {
+        co_return std::unexpected(selection.error());
     }
 
-    auto it = rg::find_if(*installed, [&config_name](const auto& inst) {
-        return inst.name() == config_name;
-    });
+    co_return build_auto_install(*selection);
+}
 
-    if (it == installed->end()) {
-        co_return std::unexpected(Error::NotInstalled);
+CommandResult
+build_auto_install(const AutoSelection& selection)
+{
+    if (selection.install.empty()) {
+        return std::unexpected(Error::AlreadyInstalled);
     }
 
-    const Config& config = *it;
+    auto packages = selection.install
+        | rg::views::transform(&Config::name)
+        | rg::to<std::vector<std::string>>();
+
+    return agent::make_install(std::move(packages));
+}
+
+Task<CommandResult>
+build_remove(
+    const ConfigProvider& provider,
+    const std::string& config_name,
+    BusType type)
+{
+    auto config = co_await provider.find_installed_config(config_name, type);
+    if (!config) {
+        co_return std::unexpected(Error::NotInstalled);
+    }
 
-    auto required_by = co_await provider.find_required_by(config, type);
+    auto required_by = co_await provider.find_required_by(*config, type);
     if (!required_by.empty()) {
         co_return std::unexpected(Error::RequiredByOthers);
     }
@@ -0,0 +1,37 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "PciSysfsScanner.hpp"
+
+
+namespace mcp::mhwd {
+
+bool PciSysfsScanner::is_device_entry(const std::string& name)
+{
+    return !name.empty() && name.front() != '.';
+}
+
+std::optional<DeviceInfo> PciSysfsScanner::read_info(int /*bus_fd*/, int dev_fd, const std::string& /*name*/)
+{
+    using namespace sysfs;
+
+    unsigned long vendor = read_hex_attr(dev_fd, "vendor");
+    unsigned long device_id = read_hex_attr(dev_fd, "device");
+    if (vendor == 0 && device_id == 0) {
+        return std::nullopt;
+    }
+
+    unsigned long class_id = read_hex_attr(dev_fd, "class");
+
+    return DeviceInfo{
+        .class_id = static_cast<HardwareId>((class_id >> 8) & 0xFFFF),
+        .vendor_id = static_cast<HardwareId>(vendor),
+        .device_id = static_cast<HardwareId>(device_id),
+    };
+}
+
+} // namespace mcp::mhwd
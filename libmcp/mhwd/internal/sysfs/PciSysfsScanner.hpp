@@ -0,0 +1,36 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * PCI bus sysfs scanner.
+ * Reads vendor, device and class attributes directly from sysfs.
+ */
+
+#pragma once
+
+#include "SysfsScanner.hpp"
+
+namespace mcp::mhwd {
+
+/**
+ * Scans /sys/bus/pci/devices without libudev device lookups.
+ */
+class PciSysfsScanner : public SysfsScanner<PciSysfsScanner> {
+public:
+    using SysfsScanner<PciSysfsScanner>::scan;
+
+private:
+    friend class SysfsScanner<PciSysfsScanner>;
+
+    static constexpr const char* subsystem() { return "pci"; }
+    static constexpr BusType bus_type() { return BusType::PCI; }
+
+    static bool is_device_entry(const std::string& name);
+    static std::optional<DeviceInfo> read_info(int bus_fd, int dev_fd, const std::string& name);
+};
+
+} // namespace mcp::mhwd
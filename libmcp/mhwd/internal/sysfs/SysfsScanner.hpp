@@ -0,0 +1,92 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Base sysfs scanner template using CRTP pattern.
+ * Reads numeric IDs straight from /sys/bus/<bus>/devices, bypassing the
+ * udev device and property database.
+ */
+
+#pragma once
+
+#include "../../Types.hpp"
+#include "../../Device.hpp"
+#include "SysfsUtils.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mcp::mhwd {
+
+template<typename Derived>
+class SysfsScanner {
+public:
+    /**
+     * Scan devices below sysfs_root (normally "/sys").
+     * Output order matches the udev scanners (sorted by sysfs path).
+     */
+    static std::vector<Device> scan(const std::filesystem::path& sysfs_root)
+    {
+        namespace fs = std::filesystem;
+
+        const auto bus_path = sysfs_root / "bus" / Derived::subsystem() / "devices";
+        sysfs::FileDescriptor bus_fd(::open(bus_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        if (!bus_fd) {
+            return {};
+        }
+
+        std::vector<std::string> names;
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(bus_path, ec)) {
+            auto name = entry.path().filename().string();
+            if (Derived::is_device_entry(name)) {
+                names.push_back(std::move(name));
+            }
+        }
+
+        std::vector<DeviceInfo> infos;
+        infos.reserve(names.size());
+
+        // Only numeric IDs are read here, names come from NameCache on demand
+
+        for (const auto& name : names) {
+            auto dev_fd = sysfs::open_dir(bus_fd.get(), name.c_str());
+            if (!dev_fd) {
+                continue;
+            }
+
+            auto info = Derived::read_info(bus_fd.get(), dev_fd.get(), name);
+            if (!info) {
+                continue;
+            }
+
+            // Bus entries are symlinks, report the same /sys/devices path udev does
+            auto syspath = fs::canonical(bus_path / name, ec);
+            info->sysfs_id = ec ? (bus_path / name).string() : syspath.string();
+            info->sysfs_bus_id = name;
+            info->driver = sysfs::read_link_name(dev_fd.get(), "driver");
+
+            infos.push_back(std::move(*info));
+        }
+
+        std::ranges::sort(infos, {}, &DeviceInfo::sysfs_id);
+
+        std::vector<Device> devices;
+        devices.reserve(infos.size());
+
+        for (auto& info : infos) {
+            devices.emplace_back(std::move(info), Derived::bus_type());
+        }
+
+        return devices;
+    }
+};
+
+} // namespace mcp::mhwd
@@ -0,0 +1,134 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Minimal fd-relative sysfs attribute readers.
+ * Attributes are opened relative to an already open device directory,
+ * so each read is a single openat + pread without path resolution.
+ */
+
+#pragma once
+
+#include "../../Types.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <charconv>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace mcp::mhwd::sysfs {
+
+// Owning file descriptor
+class FileDescriptor {
+public:
+    FileDescriptor() = default;
+    explicit FileDescriptor(int fd) : fd_(fd) {}
+    ~FileDescriptor() { reset(); }
+
+    FileDescriptor(FileDescriptor&& other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+    FileDescriptor& operator=(FileDescriptor&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            fd_ = std::exchange(other.fd_, -1);
+        }
+        return *this;
+    }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    [[nodiscard]] int get() const { return fd_; }
+    explicit operator bool() const { return fd_ >= 0; }
+
+    void reset()
+    {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+private:
+    int fd_ = -1;
+};
+
+inline FileDescriptor open_dir(int dir_fd, const char* name)
+{
+    return FileDescriptor(::openat(dir_fd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+}
+
+// Attribute values are short ("0x10de\n"), a small stack buffer is enough
+using AttrBuffer = std::array<char, 64>;
+
+inline std::optional<std::string_view> read_attr(int dir_fd, const char* name, AttrBuffer& buffer)
+{
+    FileDescriptor fd(::openat(dir_fd, name, O_RDONLY | O_CLOEXEC));
+    if (!fd) {
+        return std::nullopt;
+    }
+
+    const auto size = ::pread(fd.get(), buffer.data(), buffer.size(), 0);
+    if (size <= 0) {
+        return std::nullopt;
+    }
+
+    std::string_view value(buffer.data(), static_cast<std::size_t>(size));
+    while (!value.empty() && (value.back() == '\n' || value.back() == ' ')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+// Parse "0x10de" or "10de", 0 on failure (matching udev::hex_to_ulong)
+inline unsigned long parse_hex(std::string_view value)
+{
+    if (value.starts_with("0x") || value.starts_with("0X")) {
+        value.remove_prefix(2);
+    }
+
+    unsigned long result = 0;
+    std::from_chars(value.data(), value.data() + value.size(), result, 16);
+    return result;
+}
+
+inline unsigned long read_hex_attr(int dir_fd, const char* name)
+{
+    AttrBuffer buffer;
+    auto value = read_attr(dir_fd, name, buffer);
+    return value ? parse_hex(*value) : 0;
+}
+
+inline std::string read_string_attr(int dir_fd, const char* name)
+{
+    AttrBuffer buffer;
+    auto value = read_attr(dir_fd, name, buffer);
+    return value ? std::string(*value) : std::string{};
+}
+
+// Last path component of a symlink, e.g. the bound driver's name
+inline std::string read_link_name(int dir_fd, const char* name)
+{
+    std::array<char, 256> buffer;
+    const auto size = ::readlinkat(dir_fd, name, buffer.data(), buffer.size());
+    if (size <= 0) {
+        return {};
+    }
+
+    std::string_view target(buffer.data(), static_cast<std::size_t>(size));
+    if (auto slash = target.rfind('/'); slash != std::string_view::npos) {
+        target.remove_prefix(slash + 1);
+    }
+    return std::string(target);
+}
+
+} // namespace mcp::mhwd::sysfs
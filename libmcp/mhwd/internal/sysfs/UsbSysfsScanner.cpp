@@ -0,0 +1,53 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "UsbSysfsScanner.hpp"
+
+#include <format>
+
+namespace mcp::mhwd {
+
+bool UsbSysfsScanner::is_device_entry(const std::string& name)
+{
+    // "1-1.2:1.0" style entries are interfaces, not devices
+    return !name.empty() && name.front() != '.' && name.find(':') == std::string::npos;
+}
+
+std::optional<DeviceInfo> UsbSysfsScanner::read_info(int bus_fd, int dev_fd, const std::string& name)
+{
+    using namespace sysfs;
+
+    unsigned long vendor = read_hex_attr(dev_fd, "idVendor");
+    unsigned long product = read_hex_attr(dev_fd, "idProduct");
+    if (vendor == 0 && product == 0) {
+        return std::nullopt;
+    }
+
+    unsigned long dev_class = read_hex_attr(dev_fd, "bDeviceClass");
+    unsigned long dev_subclass = read_hex_attr(dev_fd, "bDeviceSubClass");
+
+    // Composite devices report class 0 at device level - use the first interface
+    if (dev_class == 0) {
+        AttrBuffer buffer;
+        auto config = read_attr(dev_fd, "bConfigurationValue", buffer);
+        auto iface = std::format("{}:{}.0", name, config ? *config : "1");
+
+        if (auto iface_fd = open_dir(bus_fd, iface.c_str())) {
+            dev_class = read_hex_attr(iface_fd.get(), "bInterfaceClass");
+            dev_subclass = read_hex_attr(iface_fd.get(), "bInterfaceSubClass");
+        }
+    }
+
+    return DeviceInfo{
+        .class_id = static_cast<HardwareId>(((dev_class & 0xFF) << 8) | (dev_subclass & 0xFF)),
+        .vendor_id = static_cast<HardwareId>(vendor),
+        .device_id = static_cast<HardwareId>(product),
+        .device_name = read_string_attr(dev_fd, "product"),
+    };
+}
+
+} // namespace mcp::mhwd
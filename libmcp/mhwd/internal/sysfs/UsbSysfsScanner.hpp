@@ -0,0 +1,36 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * USB bus sysfs scanner.
+ * Reads idVendor, idProduct and class attributes directly from sysfs.
+ */
+
+#pragma once
+
+#include "SysfsScanner.hpp"
+
+namespace mcp::mhwd {
+
+/**
+ * Scans /sys/bus/usb/devices without libudev device lookups.
+ */
+class UsbSysfsScanner : public SysfsScanner<UsbSysfsScanner> {
+public:
+    using SysfsScanner<UsbSysfsScanner>::scan;
+
+private:
+    friend class SysfsScanner<UsbSysfsScanner>;
+
+    static constexpr const char* subsystem() { return "usb"; }
+    static constexpr BusType bus_type() { return BusType::USB; }
+
+    static bool is_device_entry(const std::string& name);
+    static std::optional<DeviceInfo> read_info(int bus_fd, int dev_fd, const std::string& name);
+};
+
+} // namespace mcp::mhwd
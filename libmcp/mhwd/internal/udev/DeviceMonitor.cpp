@@ -0,0 +1,172 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "DeviceMonitor.hpp"
+#include "Scanners.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include <cassert>
+#include <cstdint>
+#include <string_view>
+
+namespace mcp::mhwd {
+
+namespace {
+
+std::optional<DeviceEvent::Action> parse_action(std::string_view action)
+{
+    if (action == "add") {
+        return DeviceEvent::Action::Add;
+    }
+    if (action == "remove") {
+        return DeviceEvent::Action::Remove;
+    }
+    // Driver (un)binding changes what Device::driver() reports
+    if (action == "change" || action == "bind" || action == "unbind") {
+        return DeviceEvent::Action::Change;
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+DeviceMonitor::DeviceMonitor(Handler handler)
+    : handler_(std::move(handler))
+{
+}
+
+DeviceMonitor::~DeviceMonitor()
+{
+    stop();
+}
+
+bool DeviceMonitor::start()
+{
+    if (running_) {
+        return true;
+    }
+
+    udev_.reset(udev_new());
+    if (!udev_) {
+        return false;
+    }
+
+    monitor_.reset(udev_monitor_new_from_netlink(udev_.get(), "udev"));
+    if (!monitor_) {
+        return false;
+    }
+
+    for (auto type : c_bus_types) {
+        const auto filter = subsystem_filter(type);
+        udev_monitor_filter_add_match_subsystem_devtype(monitor_.get(), filter.subsystem, filter.devtype);
+    }
+
+    if (udev_monitor_enable_receiving(monitor_.get()) < 0) {
+        monitor_.reset();
+        return false;
+    }
+
+    // The scheduler polls a single fd, an epoll set lets stop() interrupt the wait
+    wake_fd_ = sysfs::FileDescriptor(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+    epoll_fd_ = sysfs::FileDescriptor(::epoll_create1(EPOLL_CLOEXEC));
+    if (!wake_fd_ || !epoll_fd_) {
+        monitor_.reset();
+        return false;
+    }
+
+    for (const int fd : {udev_monitor_get_fd(monitor_.get()), wake_fd_.get()}) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(epoll_fd_.get(), EPOLL_CTL_ADD, fd, &event) < 0) {
+            monitor_.reset();
+            return false;
+        }
+    }
+
+    stopping_ = false;
+    running_ = true;
+    io_scheduler().spawn(run());
+    return true;
+}
+
+void DeviceMonitor::stop()
+{
+    if (!running_) {
+        return;
+    }
+
+    // The loop only exits on a scheduler thread, waiting on one could starve it
+    assert(!on_io_scheduler());
+
+    stopping_ = true;
+    const std::uint64_t wake = 1;
+    [[maybe_unused]] const auto written = ::write(wake_fd_.get(), &wake, sizeof(wake));
+    running_.wait(true);
+
+    monitor_.reset();
+    udev_.reset();
+    epoll_fd_.reset();
+    wake_fd_.reset();
+}
+
+Task<void> DeviceMonitor::run()
+{
+    while (!stopping_) {
+        auto status = co_await io_scheduler().poll(epoll_fd_.get(), coro::poll_op::read);
+        if (status == coro::poll_status::error || status == coro::poll_status::closed) {
+            break;
+        }
+        if (status != coro::poll_status::event || stopping_) {
+            continue;
+        }
+
+        if (auto events = drain(); !events.empty() && !stopping_) {
+            handler_(std::move(events));
+        }
+    }
+
+    running_ = false;
+    running_.notify_all();
+}
+
+std::vector<DeviceEvent> DeviceMonitor::drain()
+{
+    std::vector<DeviceEvent> events;
+
+    // The monitor socket is non-blocking, read everything queued so far
+    while (udev::UdevDevicePtr device{udev_monitor_receive_device(monitor_.get())}) {
+        auto action = parse_action(udev::safe_string(udev_device_get_action(device.get())));
+        if (!action) {
+            continue;
+        }
+
+        auto bus_type = bus_from_subsystem(udev::safe_string(udev_device_get_subsystem(device.get())));
+        if (!bus_type) {
+            continue;
+        }
+
+        DeviceEvent event{
+            .action = *action,
+            .bus_type = *bus_type,
+            .syspath = udev::safe_string(udev_device_get_syspath(device.get())),
+            .device = std::nullopt,
+        };
+
+        if (event.action != DeviceEvent::Action::Remove) {
+            event.device = device_from_udev(*bus_type, device.get());
+        }
+
+        events.push_back(std::move(event));
+    }
+
+    return events;
+}
+
+} // namespace mcp::mhwd
@@ -0,0 +1,80 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * udev hotplug monitor for all supported buses.
+ * Polls the netlink socket on mcp::io_scheduler() and reports batches of events.
+ */
+
+#pragma once
+
+#include "../../Types.hpp"
+#include "../../Device.hpp"
+#include "UdevUtils.hpp"
+#include "../sysfs/SysfsUtils.hpp"
+
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mcp::mhwd {
+
+/**
+ * Single udev event translated to the device model.
+ */
+struct DeviceEvent {
+    enum class Action { Add, Remove, Change };
+
+    Action action;
+    BusType bus_type;
+    std::string syspath;
+    std::optional<Device> device;   // Current state, nullopt on remove
+};
+
+/**
+ * Long-lived udev monitor.
+ *
+ * Events that arrive together are delivered as one batch, on a
+ * scheduler thread. stop() wakes the polling loop and blocks until it
+ * has exited, so the handler is never called after it returns. It must
+ * not be called from a scheduler thread, the handler included.
+ */
+class DeviceMonitor {
+public:
+    using Handler = std::function<void(std::vector<DeviceEvent>)>;
+
+    explicit DeviceMonitor(Handler handler);
+    ~DeviceMonitor();
+
+    DeviceMonitor(const DeviceMonitor&) = delete;
+    DeviceMonitor& operator=(const DeviceMonitor&) = delete;
+
+    /**
+     * Open the monitor socket and start polling.
+     * Returns false if udev is unavailable.
+     */
+    bool start();
+
+    void stop();
+
+private:
+    Task<void> run();
+    std::vector<DeviceEvent> drain();
+
+    Handler handler_;
+    udev::UdevPtr udev_;
+    udev::UdevMonitorPtr monitor_;
+    sysfs::FileDescriptor wake_fd_;   // eventfd written by stop()
+    sysfs::FileDescriptor epoll_fd_;  // Monitor socket and wake_fd_, polled as one
+
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> running_{false};
+};
+
+} // namespace mcp::mhwd
@@ -16,10 +16,26 @@
 #include "UdevUtils.hpp"
 #include "../../Device.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace mcp::mhwd {
 
+/**
+ * Derived scanners provide subsystem(), bus_type(), is_valid() and
+ * extract_info(). Setting
+ *
+ *   static constexpr bool parallel_extraction = true;
+ *
+ * on a scanner collects syspaths first and extracts devices in chunks on
+ * worker threads, each with its own udev context. Output order is the
+ * enumeration order either way.
+ */
 template<typename Derived>
 class DeviceScanner {
 public:
@@ -27,35 +43,104 @@ public:
     {
         using namespace udev;
         
-        std::vector<Device> devices;
-
         UdevPtr udev_ctx(udev_new());
         if (!udev_ctx) {
-            return devices;
+            return {};
         }
 
         UdevEnumeratePtr enumerate(udev_enumerate_new(udev_ctx.get()));
         if (!enumerate) {
-            return devices;
+            return {};
         }
 
         udev_enumerate_add_match_subsystem(enumerate.get(), Derived::subsystem());
         udev_enumerate_scan_devices(enumerate.get());
 
+        std::vector<std::string> syspaths;
+
         udev_list_entry* entry;
         udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(enumerate.get()))
         {
-            const char* syspath = udev_list_entry_get_name(entry);
-            UdevDevicePtr device(udev_device_new_from_syspath(udev_ctx.get(), syspath));
-            
-            if (!device || !Derived::is_valid(device.get())) {
+            syspaths.emplace_back(udev_list_entry_get_name(entry));
+        }
+
+        if constexpr (requires { requires Derived::parallel_extraction; }) {
+            if (syspaths.size() >= 2 * c_min_chunk_size) {
+                return extract_parallel(syspaths);
+            }
+        }
+
+        return extract_range(udev_ctx.get(), syspaths);
+    }
+
+    /**
+     * Build a Device from a single udev device (e.g. a hotplug event).
+     * Returns nullopt if the device is not of interest on this bus.
+     */
+    static std::optional<Device> from_udev(udev_device* device)
+    {
+        if (!Derived::is_valid(device)) {
+            return std::nullopt;
+        }
+
+        DeviceInfo info = Derived::extract_info(device, udev_device_get_syspath(device));
+        return Device(std::move(info), Derived::bus_type());
+    }
+
+private:
+    // Below this many devices per worker, thread startup costs more than it saves
+    static constexpr std::size_t c_min_chunk_size = 16;
+
+    static std::vector<Device> extract_range(::udev* udev_ctx, std::span<const std::string> syspaths)
+    {
+        std::vector<Device> devices;
+        devices.reserve(syspaths.size());
+
+        for (const auto& syspath : syspaths) {
+            udev::UdevDevicePtr device(udev_device_new_from_syspath(udev_ctx, syspath.c_str()));
+            if (!device) {
                 continue;
             }
 
-            DeviceInfo info = Derived::extract_info(device.get(), syspath);
-            devices.emplace_back(std::move(info), Derived::bus_type());
+            if (auto parsed = from_udev(device.get())) {
+                devices.push_back(std::move(*parsed));
+            }
+        }
+
+        return devices;
+    }
+
+    static std::vector<Device> extract_parallel(const std::vector<std::string>& syspaths)
+    {
+        const std::size_t max_workers = std::max(1u, std::thread::hardware_concurrency());
+        const std::size_t workers = std::min(max_workers, syspaths.size() / c_min_chunk_size);
+        const std::size_t chunk_size = (syspaths.size() + workers - 1) / workers;
+
+        // One result slot per chunk, concatenated in chunk order afterwards
+        std::vector<std::vector<Device>> chunks(workers);
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(workers);
+
+            for (std::size_t i = 0; i < workers; ++i) {
+                const auto begin = std::min(i * chunk_size, syspaths.size());
+                const auto end = std::min(begin + chunk_size, syspaths.size());
+
+                threads.emplace_back([&chunks, &syspaths, i, begin, end] {
+                    // udev contexts are not thread-safe, each worker gets its own
+                    udev::UdevPtr udev_ctx(udev_new());
+                    if (udev_ctx) {
+                        chunks[i] = extract_range(udev_ctx.get(),
+                                                  std::span(syspaths).subspan(begin, end - begin));
+                    }
+                });
+            }
         }
 
+        std::vector<Device> devices;
+        for (auto& chunk : chunks) {
+            std::ranges::move(chunk, std::back_inserter(devices));
+        }
         return devices;
     }
 };
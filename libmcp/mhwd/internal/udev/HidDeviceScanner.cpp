@@ -0,0 +1,41 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "HidDeviceScanner.hpp"
+#include "UdevUtils.hpp"
+
+namespace mcp::mhwd {
+
+DeviceInfo HidDeviceScanner::extract_info(udev_device* device, const char* syspath)
+{
+    using namespace udev;
+
+    // HID_ID is "BBBB:VVVVVVVV:PPPPPPPP"
+    const char* hid_id = udev_device_get_property_value(device, "HID_ID");
+    char* cursor = nullptr;
+    unsigned long bus = std::strtoul(hid_id, &cursor, 16);
+    unsigned long vendor = (*cursor == ':') ? std::strtoul(cursor + 1, &cursor, 16) : 0;
+    unsigned long product = (*cursor == ':') ? std::strtoul(cursor + 1, &cursor, 16) : 0;
+
+    return DeviceInfo{
+        .class_id = static_cast<HardwareId>(bus),
+        .vendor_id = static_cast<HardwareId>(vendor),
+        .device_id = static_cast<HardwareId>(product),
+        .device_name = safe_property(device, "HID_NAME"),
+        .sysfs_bus_id = safe_string(udev_device_get_sysname(device)),
+        .sysfs_id = safe_string(syspath),
+        .driver = safe_string(udev_device_get_driver(device))
+    };
+}
+
+bool HidDeviceScanner::is_valid(udev_device* device)
+{
+    // Property lookup only, no sysfs attribute reads
+    return udev_device_get_property_value(device, "HID_ID") != nullptr;
+}
+
+} // namespace mcp::mhwd
@@ -0,0 +1,44 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * HID bus device scanner.
+ * Extracts HID device information (USB, Bluetooth and I2C HID) from udev.
+ */
+
+#pragma once
+
+#include "DeviceScanner.hpp"
+
+struct udev_device;
+
+namespace mcp::mhwd {
+
+/**
+ * Scans HID bus for devices using udev.
+ *
+ * HID has no class code; the transport bus from HID_ID (0003 USB,
+ * 0005 Bluetooth, 0018 I2C) is reported as class ID instead, so configs
+ * can target e.g. I2C touchpads only.
+ */
+class HidDeviceScanner : public DeviceScanner<HidDeviceScanner> {
+public:
+    using DeviceScanner<HidDeviceScanner>::scan;
+    using DeviceScanner<HidDeviceScanner>::from_udev;
+
+    static constexpr const char* subsystem() { return "hid"; }
+
+private:
+    friend class DeviceScanner<HidDeviceScanner>;
+
+    static constexpr BusType bus_type() { return BusType::HID; }
+
+    static DeviceInfo extract_info(udev_device* device, const char* syspath);
+    static bool is_valid(udev_device* device);
+};
+
+} // namespace mcp::mhwd
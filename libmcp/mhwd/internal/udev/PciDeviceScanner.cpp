@@ -19,12 +19,9 @@ DeviceInfo PciDeviceScanner::extract_info(udev_device* device, const char* syspa
     unsigned long class_id = hex_to_ulong(udev_device_get_sysattr_value(device, "class"));
 
     return DeviceInfo{
-        .class_id = to_hex((class_id >> 8) & 0xFFFF, 4),
-        .vendor_id = to_hex(vendor, 4),
-        .device_id = to_hex(device_id, 4),
-        .class_name = safe_property(device, "ID_PCI_CLASS_FROM_DATABASE"),
-        .vendor_name = safe_property(device, "ID_VENDOR_FROM_DATABASE"),
-        .device_name = safe_property(device, "ID_MODEL_FROM_DATABASE"),
+        .class_id = static_cast<HardwareId>((class_id >> 8) & 0xFFFF),
+        .vendor_id = static_cast<HardwareId>(vendor),
+        .device_id = static_cast<HardwareId>(device_id),
         .sysfs_bus_id = safe_string(udev_device_get_sysname(device)),
         .sysfs_id = safe_string(syspath),
         .driver = safe_string(udev_device_get_driver(device))
@@ -24,11 +24,13 @@ namespace mcp::mhwd {
 class PciDeviceScanner : public DeviceScanner<PciDeviceScanner> {
 public:
     using DeviceScanner<PciDeviceScanner>::scan;
+    using DeviceScanner<PciDeviceScanner>::from_udev;
+
+    static constexpr const char* subsystem() { return "pci"; }
 
 private:
     friend class DeviceScanner<PciDeviceScanner>;
-    
-    static constexpr const char* subsystem() { return "pci"; }
+
     static constexpr BusType bus_type() { return BusType::PCI; }
     
     static DeviceInfo extract_info(udev_device* device, const char* syspath);
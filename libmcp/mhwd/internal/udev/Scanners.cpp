@@ -0,0 +1,64 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "Scanners.hpp"
+#include "HidDeviceScanner.hpp"
+#include "PciDeviceScanner.hpp"
+#include "SdioDeviceScanner.hpp"
+#include "ThunderboltDeviceScanner.hpp"
+#include "UsbDeviceScanner.hpp"
+
+namespace mcp::mhwd {
+
+namespace {
+
+template<typename Fn>
+auto visit_scanner(BusType type, Fn&& fn)
+{
+    switch (type) {
+        case BusType::PCI:         return fn(PciDeviceScanner{});
+        case BusType::USB:         return fn(UsbDeviceScanner{});
+        case BusType::SDIO:        return fn(SdioDeviceScanner{});
+        case BusType::HID:         return fn(HidDeviceScanner{});
+        case BusType::Thunderbolt: return fn(ThunderboltDeviceScanner{});
+    }
+    return fn(PciDeviceScanner{});
+}
+
+} // namespace
+
+SubsystemFilter subsystem_filter(BusType type)
+{
+    switch (type) {
+        case BusType::USB:         return {UsbDeviceScanner::subsystem(), "usb_device"};
+        case BusType::Thunderbolt: return {ThunderboltDeviceScanner::subsystem(), ThunderboltDeviceScanner::devtype()};
+        default:
+            return {visit_scanner(type, [](auto scanner) { return decltype(scanner)::subsystem(); }), nullptr};
+    }
+}
+
+std::optional<BusType> bus_from_subsystem(std::string_view subsystem)
+{
+    for (auto type : c_bus_types) {
+        if (subsystem == subsystem_filter(type).subsystem) {
+            return type;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<Device> scan_udev(BusType type)
+{
+    return visit_scanner(type, [](auto scanner) { return decltype(scanner)::scan(); });
+}
+
+std::optional<Device> device_from_udev(BusType type, udev_device* device)
+{
+    return visit_scanner(type, [device](auto scanner) { return decltype(scanner)::from_udev(device); });
+}
+
+} // namespace mcp::mhwd
@@ -0,0 +1,39 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Runtime dispatch from BusType to the matching udev scanner.
+ */
+
+#pragma once
+
+#include "../../Types.hpp"
+#include "../../Device.hpp"
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+struct udev_device;
+
+namespace mcp::mhwd {
+
+/**
+ * udev subsystem (and devtype, if any) a bus is scanned and monitored with.
+ */
+struct SubsystemFilter {
+    const char* subsystem;
+    const char* devtype;
+};
+
+[[nodiscard]] SubsystemFilter subsystem_filter(BusType type);
+[[nodiscard]] std::optional<BusType> bus_from_subsystem(std::string_view subsystem);
+
+[[nodiscard]] std::vector<Device> scan_udev(BusType type);
+[[nodiscard]] std::optional<Device> device_from_udev(BusType type, udev_device* device);
+
+} // namespace mcp::mhwd
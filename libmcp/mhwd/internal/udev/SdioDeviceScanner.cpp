@@ -0,0 +1,40 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "SdioDeviceScanner.hpp"
+#include "UdevUtils.hpp"
+
+namespace mcp::mhwd {
+
+DeviceInfo SdioDeviceScanner::extract_info(udev_device* device, const char* syspath)
+{
+    using namespace udev;
+
+    // SDIO_ID is "VVVV:DDDD", both it and SDIO_CLASS come from the uevent
+    const char* sdio_id = udev_device_get_property_value(device, "SDIO_ID");
+    char* separator = nullptr;
+    unsigned long vendor = sdio_id ? std::strtoul(sdio_id, &separator, 16) : 0;
+    unsigned long device_id = (separator && *separator == ':') ? hex_to_ulong(separator + 1) : 0;
+    unsigned long sdio_class = hex_to_ulong(udev_device_get_property_value(device, "SDIO_CLASS"));
+
+    return DeviceInfo{
+        .class_id = static_cast<HardwareId>((sdio_class & 0xFF) << 8),
+        .vendor_id = static_cast<HardwareId>(vendor),
+        .device_id = static_cast<HardwareId>(device_id),
+        .sysfs_bus_id = safe_string(udev_device_get_sysname(device)),
+        .sysfs_id = safe_string(syspath),
+        .driver = safe_string(udev_device_get_driver(device))
+    };
+}
+
+bool SdioDeviceScanner::is_valid(udev_device* device)
+{
+    // Property lookup only, no sysfs attribute reads
+    return udev_device_get_property_value(device, "SDIO_ID") != nullptr;
+}
+
+} // namespace mcp::mhwd
@@ -0,0 +1,40 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * SDIO bus device scanner.
+ * Extracts SDIO function information (typically Wi-Fi/Bluetooth) from udev.
+ */
+
+#pragma once
+
+#include "DeviceScanner.hpp"
+
+struct udev_device;
+
+namespace mcp::mhwd {
+
+/**
+ * Scans SDIO bus for devices using udev.
+ */
+class SdioDeviceScanner : public DeviceScanner<SdioDeviceScanner> {
+public:
+    using DeviceScanner<SdioDeviceScanner>::scan;
+    using DeviceScanner<SdioDeviceScanner>::from_udev;
+
+    static constexpr const char* subsystem() { return "sdio"; }
+
+private:
+    friend class DeviceScanner<SdioDeviceScanner>;
+
+    static constexpr BusType bus_type() { return BusType::SDIO; }
+
+    static DeviceInfo extract_info(udev_device* device, const char* syspath);
+    static bool is_valid(udev_device* device);
+};
+
+} // namespace mcp::mhwd
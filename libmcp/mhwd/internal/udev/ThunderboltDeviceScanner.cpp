@@ -0,0 +1,40 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "ThunderboltDeviceScanner.hpp"
+#include "UdevUtils.hpp"
+
+#include <string_view>
+
+namespace mcp::mhwd {
+
+DeviceInfo ThunderboltDeviceScanner::extract_info(udev_device* device, const char* syspath)
+{
+    using namespace udev;
+
+    unsigned long vendor = hex_to_ulong(udev_device_get_sysattr_value(device, "vendor"));
+    unsigned long device_id = hex_to_ulong(udev_device_get_sysattr_value(device, "device"));
+
+    // Routers carry their names in sysfs, hwdb has no Thunderbolt entries
+    return DeviceInfo{
+        .vendor_id = static_cast<HardwareId>(vendor),
+        .device_id = static_cast<HardwareId>(device_id),
+        .device_name = safe_attr(device, "device_name"),
+        .sysfs_bus_id = safe_string(udev_device_get_sysname(device)),
+        .sysfs_id = safe_string(syspath),
+        .driver = safe_string(udev_device_get_driver(device))
+    };
+}
+
+bool ThunderboltDeviceScanner::is_valid(udev_device* device)
+{
+    // Devtype is part of the uevent, this filters domains and XDomain services cheaply
+    const char* type = udev_device_get_devtype(device);
+    return type && std::string_view(type) == devtype();
+}
+
+} // namespace mcp::mhwd
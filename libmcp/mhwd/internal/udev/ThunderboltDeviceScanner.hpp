@@ -0,0 +1,41 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * Thunderbolt/USB4 bus device scanner.
+ * Extracts router (device) information from udev, skipping domains and services.
+ */
+
+#pragma once
+
+#include "DeviceScanner.hpp"
+
+struct udev_device;
+
+namespace mcp::mhwd {
+
+/**
+ * Scans Thunderbolt bus for devices using udev.
+ */
+class ThunderboltDeviceScanner : public DeviceScanner<ThunderboltDeviceScanner> {
+public:
+    using DeviceScanner<ThunderboltDeviceScanner>::scan;
+    using DeviceScanner<ThunderboltDeviceScanner>::from_udev;
+
+    static constexpr const char* subsystem() { return "thunderbolt"; }
+    static constexpr const char* devtype() { return "thunderbolt_device"; }
+
+private:
+    friend class DeviceScanner<ThunderboltDeviceScanner>;
+
+    static constexpr BusType bus_type() { return BusType::Thunderbolt; }
+
+    static DeviceInfo extract_info(udev_device* device, const char* syspath);
+    static bool is_valid(udev_device* device);
+};
+
+} // namespace mcp::mhwd
@@ -15,7 +15,7 @@ extern "C" {
 #include <libudev.h>
 }
 
-#include <format>
+#include <cstdlib>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -50,16 +50,31 @@ struct UdevDeviceDeleter {
     }
 };
 
+struct UdevMonitorDeleter {
+    void operator()(::udev_monitor* monitor) const
+    {
+        if (monitor) {
+            udev_monitor_unref(monitor);
+        }
+    }
+};
+
+struct UdevHwdbDeleter {
+    void operator()(::udev_hwdb* hwdb) const
+    {
+        if (hwdb) {
+            udev_hwdb_unref(hwdb);
+        }
+    }
+};
+
 using UdevPtr = std::unique_ptr<::udev, UdevDeleter>;
 using UdevEnumeratePtr = std::unique_ptr<::udev_enumerate, UdevEnumerateDeleter>;
 using UdevDevicePtr = std::unique_ptr<::udev_device, UdevDeviceDeleter>;
+using UdevMonitorPtr = std::unique_ptr<::udev_monitor, UdevMonitorDeleter>;
+using UdevHwdbPtr = std::unique_ptr<::udev_hwdb, UdevHwdbDeleter>;
 
 // String conversion utilities
-inline std::string to_hex(unsigned long value, int width)
-{
-    return std::format("{:0{}x}", value, width);
-}
-
 inline std::string safe_string(const char* str)
 {
     return str ? std::string(str) : std::string{};
@@ -77,6 +92,19 @@ inline std::string safe_property(::udev_device* device, std::string_view propert
     return safe_string(value);
 }
 
+// First value of key among hwdb entries matching modalias
+inline std::string hwdb_property(::udev_hwdb* hwdb, const std::string& modalias, std::string_view key)
+{
+    udev_list_entry* entry;
+    udev_list_entry_foreach(entry, udev_hwdb_get_properties_list_entry(hwdb, modalias.c_str(), 0))
+    {
+        if (key == udev_list_entry_get_name(entry)) {
+            return safe_string(udev_list_entry_get_value(entry));
+        }
+    }
+    return {};
+}
+
 inline unsigned long hex_to_ulong(const char* hex_str)
 {
     if (!hex_str) return 0;
@@ -33,18 +33,11 @@ DeviceInfo UsbDeviceScanner::extract_info(udev_device* device, const char* syspa
         }
     }
 
-    std::string device_name = safe_property(device, "ID_MODEL_FROM_DATABASE");
-    if (device_name.empty()) {
-        device_name = safe_property(device, "ID_MODEL");
-    }
-
     return DeviceInfo{
-        .class_id = to_hex((dev_class << 8) | dev_subclass, 4),
-        .vendor_id = to_hex(vendor, 4),
-        .device_id = to_hex(product, 4),
-        .class_name = safe_property(device, "ID_USB_CLASS_FROM_DATABASE"),
-        .vendor_name = safe_property(device, "ID_VENDOR_FROM_DATABASE"),
-        .device_name = std::move(device_name),
+        .class_id = static_cast<HardwareId>(((dev_class & 0xFF) << 8) | (dev_subclass & 0xFF)),
+        .vendor_id = static_cast<HardwareId>(vendor),
+        .device_id = static_cast<HardwareId>(product),
+        .device_name = safe_property(device, "ID_MODEL"),
         .sysfs_bus_id = safe_string(udev_device_get_sysname(device)),
         .sysfs_id = safe_string(syspath),
         .driver = safe_string(udev_device_get_driver(device))
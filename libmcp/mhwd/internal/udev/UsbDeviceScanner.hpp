@@ -24,11 +24,16 @@ namespace mcp::mhwd {
 class UsbDeviceScanner : public DeviceScanner<UsbDeviceScanner> {
 public:
     using DeviceScanner<UsbDeviceScanner>::scan;
+    using DeviceScanner<UsbDeviceScanner>::from_udev;
+
+    static constexpr const char* subsystem() { return "usb"; }
 
 private:
     friend class DeviceScanner<UsbDeviceScanner>;
-    
-    static constexpr const char* subsystem() { return "usb"; }
+
+    // Docks and Thunderbolt chains can expose hundreds of USB nodes
+    static constexpr bool parallel_extraction = true;
+
     static constexpr BusType bus_type() { return BusType::USB; }
     
     static DeviceInfo extract_info(udev_device* device, const char* syspath);
@@ -10,6 +10,8 @@
 #include <QStringList>
 #include <QtQml>
 
+#include <kernel/Kernel.hpp>
+
 namespace mcp::qt::kernel {
 
 /*
@@ -30,6 +32,9 @@ class KernelData
     Q_PROPERTY(bool isInstalled MEMBER isInstalled)
     Q_PROPERTY(bool isRecommended MEMBER isRecommended)
     Q_PROPERTY(bool isLTS MEMBER isLTS)
+    Q_PROPERTY(bool isRealTime MEMBER isRealTime)
+    Q_PROPERTY(bool isEOL MEMBER isEOL)
+    Q_PROPERTY(bool isExperimental MEMBER isExperimental)
     Q_PROPERTY(bool valid READ isValid)
 
 public:
@@ -43,9 +48,34 @@ public:
     bool isInstalled = false;
     bool isRecommended = false;
     bool isLTS = false;
+    bool isRealTime = false;
+    bool isEOL = false;
+    bool isExperimental = false;
 
     bool isValid() const { return !name.isEmpty(); }
 
+    static KernelData fromKernel(const mcp::kernel::Kernel& kernel)
+    {
+        KernelData data;
+        data.name = QString::fromStdString(kernel.package_name);
+        data.version = QString::fromStdString(kernel.version.to_string());
+        data.majorVersion = kernel.version.major;
+        data.minorVersion = kernel.version.minor;
+        data.changelogUrl = QString::fromStdString(kernel.changelog_url);
+        data.extraModules.reserve(static_cast<qsizetype>(kernel.extra_modules.size()));
+        for (const auto& mod : kernel.extra_modules) {
+            data.extraModules.append(QString::fromStdString(mod));
+        }
+        data.isInUse = kernel.is_in_use();
+        data.isInstalled = kernel.is_installed();
+        data.isRecommended = kernel.is_recommended();
+        data.isLTS = kernel.is_lts();
+        data.isRealTime = kernel.flags.real_time;
+        data.isEOL = kernel.flags.not_supported;
+        data.isExperimental = kernel.flags.experimental;
+        return data;
+    }
+
     bool operator==(const KernelData& other) const = default;
 };
 
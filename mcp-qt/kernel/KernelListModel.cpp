@@ -7,7 +7,9 @@
 #include "KernelListModel.h"
 
 #include <QMetaEnum>
-#include "KernelData.h"
+
+#include <algorithm>
+#include <utility>
 
 namespace mcp::qt::kernel {
 
@@ -21,15 +23,16 @@ QVariant KernelListModel::data(const QModelIndex &index, int role) const
     if (!index.isValid() || index.row() < 0 || static_cast<size_t>(index.row()) >= m_filteredList.size())
         return QVariant{};
     
-    const auto &el = m_filteredList[static_cast<size_t>(index.row())];
+    const auto &row = m_filteredList[static_cast<size_t>(index.row())];
+    const auto &el = row.kernel;
 
     switch (role) {
     case Name:
-        return QString::fromStdString(el.package_name);
+        return row.data.name;
     case IsInstalled:
         return el.is_installed();
     case Version:
-        return QString::fromStdString(el.version.to_string());
+        return row.data.version;
     case IsLTS:
         return el.is_lts();
     case IsRecommended:
@@ -47,94 +50,143 @@ QVariant KernelListModel::data(const QModelIndex &index, int role) const
     case MinorVersion:
         return el.version.minor;
     case Category:
-        if (el.is_in_use())
-            return tr("In use");
-        if (el.is_installed())
-            return tr("Installed");
-        if (el.is_lts())
-            return tr("LTS");
-        return tr("Other");
+        return row.category;
     case ChangelogUrl:
-        return QString::fromStdString(el.changelog_url);
-    case ExtraModules: {
-        QStringList modules;
-        for (const auto& mod : el.extra_modules) {
-            modules.append(QString::fromStdString(mod));
-        }
-        return modules;
-    }
-    case KernelData: {
-        mcp::qt::kernel::KernelData kernelData;
-        kernelData.name = QString::fromStdString(el.package_name);
-        kernelData.version = QString::fromStdString(el.version.to_string());
-        kernelData.isInUse = el.is_in_use();
-        kernelData.isRecommended = el.is_recommended();
-        kernelData.isInstalled = el.is_installed();
-        kernelData.majorVersion = el.version.major;
-        kernelData.minorVersion = el.version.minor;
-        kernelData.changelogUrl = QString::fromStdString(el.changelog_url);
-        kernelData.isLTS = el.is_lts();
-        
-        QStringList extraModsList;
-        for (const auto& mod : el.extra_modules) {
-            extraModsList.append(QString::fromStdString(mod));
-        }
-        kernelData.extraModules = extraModsList;
-        
-        return QVariant::fromValue(kernelData);
-    }
+        return row.data.changelogUrl;
+    case ExtraModules:
+        return row.data.extraModules;
+    case KernelData:
+        return row.dataVariant;
     }
 
     return QVariant{};
 }
 
+KernelListModel::Row KernelListModel::makeRow(const mcp::kernel::Kernel &kernel) const
+{
+    Row row{kernel, mcp::qt::kernel::KernelData::fromKernel(kernel), {}, {}};
+    row.dataVariant = QVariant::fromValue(row.data);
+
+    if (kernel.is_in_use())
+        row.category = tr("In use");
+    else if (kernel.is_installed())
+        row.category = tr("Installed");
+    else if (kernel.is_lts())
+        row.category = tr("LTS");
+    else
+        row.category = tr("Other");
+
+    return row;
+}
+
 const std::vector<mcp::kernel::Kernel> &KernelListModel::list() const
 {
     return m_list;
 }
 
-void KernelListModel::setList(const std::vector<mcp::kernel::Kernel> &newList)
+namespace {
+
+// Kernel::operator== only compares identity (name and version)
+bool sameState(const mcp::kernel::Kernel &a, const mcp::kernel::Kernel &b)
 {
-    if (m_list == newList)
-        return;
-    beginResetModel();
+    return a == b
+        && a.flags == b.flags
+        && a.repo == b.repo
+        && a.installed_version == b.installed_version
+        && a.available_version == b.available_version
+        && a.changelog_url == b.changelog_url
+        && a.extra_modules == b.extra_modules;
+}
 
-    m_list = newList;
+} // namespace
 
-    auto installedEnd = std::partition(m_list.begin(), m_list.end(), [](const auto &a) {
+void KernelListModel::setList(std::vector<mcp::kernel::Kernel> list)
+{
+    auto installedEnd = std::partition(list.begin(), list.end(), [](const auto &a) {
         return a.is_in_use();
     });
     
-    auto ltsStart = std::partition(installedEnd, m_list.end(), [](const auto &a) {
+    auto ltsStart = std::partition(installedEnd, list.end(), [](const auto &a) {
         return a.is_installed() && !a.is_in_use();
     });
     
-    auto othersStart = std::partition(ltsStart, m_list.end(), [](const auto &a) {
+    auto othersStart = std::partition(ltsStart, list.end(), [](const auto &a) {
         return !a.is_installed() && a.is_lts();
     });
     
     std::sort(ltsStart, othersStart, [](const auto &a, const auto &b) {
         return a.version > b.version;
     });
-    std::sort(othersStart, m_list.end(), [](const auto &a, const auto &b) {
+    std::sort(othersStart, list.end(), [](const auto &a, const auto &b) {
         return a.version > b.version;
     });
 
-    m_filteredList.clear();
+    if (std::ranges::equal(m_list, list, sameState))
+        return;
+
+    m_list = std::move(list);
+
+    std::vector<mcp::kernel::Kernel> filtered;
     for (const auto &kernel : m_list) {
         if (!kernel.is_in_use() && !kernel.is_recommended()) {
-            m_filteredList.push_back(kernel);
+            filtered.push_back(kernel);
         }
     }
 
-    endResetModel();
+    applyFilteredList(std::move(filtered));
 
     Q_EMIT listChanged();
 }
 
-void KernelListModel::setKernels(const std::vector<mcp::kernel::Kernel> &kernels)
+void KernelListModel::applyFilteredList(std::vector<mcp::kernel::Kernel> target)
+{
+    // Keyed by package name: views keep their delegates and scroll position
+    // for kernels that are still listed, only real changes are signalled
+    auto byName = [](const std::string &name) {
+        return [&name](const mcp::kernel::Kernel &k) { return k.package_name == name; };
+    };
+
+    for (size_t row = m_filteredList.size(); row-- > 0;) {
+        if (std::ranges::none_of(target, byName(m_filteredList[row].kernel.package_name))) {
+            const int r = static_cast<int>(row);
+            beginRemoveRows({}, r, r);
+            m_filteredList.erase(m_filteredList.begin() + static_cast<std::ptrdiff_t>(row));
+            endRemoveRows();
+        }
+    }
+
+    for (size_t row = 0; row < target.size(); ++row) {
+        const auto &kernel = target[row];
+        const int r = static_cast<int>(row);
+
+        auto it = std::find_if(m_filteredList.begin() + static_cast<std::ptrdiff_t>(row),
+                               m_filteredList.end(),
+                               [&](const Row &existing) { return existing.kernel.package_name == kernel.package_name; });
+
+        if (it == m_filteredList.end()) {
+            beginInsertRows({}, r, r);
+            m_filteredList.insert(m_filteredList.begin() + r, makeRow(kernel));
+            endInsertRows();
+            continue;
+        }
+
+        if (const auto from = static_cast<int>(it - m_filteredList.begin()); from != r) {
+            beginMoveRows({}, from, from, {}, r);
+            std::rotate(m_filteredList.begin() + r, it, it + 1);
+            endMoveRows();
+        }
+
+        if (!sameState(m_filteredList[row].kernel, kernel)) {
+            m_filteredList[row] = makeRow(kernel);
+            const auto idx = index(r);
+            Q_EMIT dataChanged(idx, idx);
+        }
+    }
+}
+
+void KernelListModel::setKernels(std::vector<mcp::kernel::Kernel> kernels)
 {
-    setList(kernels);
+    setList(std::move(kernels));
 }
 
 QHash<int, QByteArray> KernelListModel::roleNames() const
@@ -6,14 +6,14 @@
  */
 #pragma once
 
+#include "KernelData.h"
+
 #include <QAbstractListModel>
 
 #include <kernel/Kernel.hpp>
 
 namespace mcp::qt::kernel {
 
-class KernelData;
-
 class KernelListModel : public QAbstractListModel
 {
     Q_OBJECT
@@ -43,15 +43,27 @@ public:
     }
 
     const std::vector<mcp::kernel::Kernel> &list() const;
-    void setList(const std::vector<mcp::kernel::Kernel> &newList);
-    void setKernels(const std::vector<mcp::kernel::Kernel> &kernels);
+    void setList(std::vector<mcp::kernel::Kernel> list);
+    void setKernels(std::vector<mcp::kernel::Kernel> kernels);
 
 Q_SIGNALS:
     void listChanged();
 
 private:
+    // Qt-side values are converted once when a row is inserted or changed,
+    // role lookups hand out implicitly shared copies
+    struct Row {
+        mcp::kernel::Kernel kernel;
+        mcp::qt::kernel::KernelData data;
+        QVariant dataVariant;
+        QString category;
+    };
+
+    Row makeRow(const mcp::kernel::Kernel &kernel) const;
+    void applyFilteredList(std::vector<mcp::kernel::Kernel> target);
+
     std::vector<mcp::kernel::Kernel> m_list;
-    std::vector<mcp::kernel::Kernel> m_filteredList;
+    std::vector<Row> m_filteredList;
 
 public:
     int rowCount(const QModelIndex &parent) const override;
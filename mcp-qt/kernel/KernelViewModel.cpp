@@ -12,7 +12,12 @@
 
 #include <kernel/Transaction.hpp>
 #include <QCoroTask>
+#include <QCoroThread>
 #include "pamac/transaction.hpp"
+#include <StartupTrace.hpp>
+
+
+#include <utility>
 
 #include <QQmlEngine>
 #include <QQuickItem>
@@ -178,63 +183,106 @@ KernelData KernelViewModel::recommendedKernelData() const
     return m_recommendedKernelData;
 }
 
+bool KernelViewModel::loading() const
+{
+    return m_loading;
+}
+
+void KernelViewModel::setLoading(bool loading)
+{
+    if (m_loading == loading)
+        return;
+    m_loading = loading;
+    Q_EMIT loadingChanged(m_loading);
+}
+
+mcp::Task<mcp::kernel::KernelResult<mcp::kernel::KernelVector>>
+KernelViewModel::loadKernels(std::shared_ptr<const mcp::kernel::KernelProvider> provider,
+                             QPointer<KernelViewModel> self)
+{
+    // libalpm search and module globbing are synchronous, keep them off the GUI thread
+    co_await mcp::io_scheduler().schedule();
+
+    // self is only checked once the call is back on the application thread
+    co_return co_await provider->get_kernels([self](int current, int total, const std::string& kernelName) {
+        QMetaObject::invokeMethod(
+            QCoreApplication::instance(),
+            [self, current, total, name = QString::fromStdString(kernelName)]() {
+                if (self) {
+                    Q_EMIT self->fetchProgress(current, total, name);
+                }
+            },
+            ::Qt::QueuedConnection);
+    });
+}
+
 void KernelViewModel::fetchAndUpdateKernels()
 {
-    // Launch async kernel fetching with QCoro
-    [this]() -> QCoro::Task<void> {
-        auto result = co_await m_provider.get_kernels();
+    // Fold refreshes requested mid-fetch into a single follow-up pass
+    if (m_loading) {
+        m_fetchPending = true;
+        return;
+    }
+    setLoading(true);
 
-        if (!result) {
-            qWarning() << "Failed to fetch kernels:" << static_cast<int>(result.error());
-            co_return;
-        }
+    QCoro::connect(updateKernels(), this, [this]() {
+        setLoading(false);
 
-        auto kernels_copy = *result;
-        
-        KernelData newInUseData;
-        KernelData newRecommendedData;
-        
-        for (const auto& kernel : kernels_copy) {
-            KernelData kernelData;
-            kernelData.name = QString::fromStdString(kernel.package_name);
-            kernelData.version = QString::fromStdString(kernel.version.to_string());
-            kernelData.isInUse = kernel.is_in_use();
-            kernelData.isRecommended = kernel.is_recommended();
-            kernelData.isInstalled = kernel.is_installed();
-            kernelData.majorVersion = kernel.version.major;
-            kernelData.minorVersion = kernel.version.minor;
-            kernelData.changelogUrl = QString::fromStdString(kernel.changelog_url);
-            kernelData.isLTS = kernel.is_lts();
-            
-            QStringList extraModsList;
-            for (const auto& mod : kernel.extra_modules) {
-                extraModsList.append(QString::fromStdString(mod));
-            }
-            kernelData.extraModules = extraModsList;
-            
-            if (kernel.is_in_use()) {
-                newInUseData = kernelData;
-            } else if (kernel.is_recommended()) {
-                newRecommendedData = kernelData;
-            }
+        if (std::exchange(m_fetchPending, false)) {
+            fetchAndUpdateKernels();
         }
+    });
+}
 
-        bool changed = false;
-        if (m_inUseKernelData != newInUseData) {
-            m_inUseKernelData = newInUseData;
-            changed = true;
-        }
-        if (m_recommendedKernelData != newRecommendedData) {
-            m_recommendedKernelData = newRecommendedData;
-            changed = true;
-        }
-        
-        if (changed) {
-            Q_EMIT kernelsDataChanged();
+QCoro::Task<void> KernelViewModel::updateKernels()
+{
+    mcp::trace::Scope scope("KernelViewModel::updateKernels");
+
+    // Resumed on a scheduler thread, where this may be going away
+    QPointer<KernelViewModel> self(this);
+    auto* guiThread = thread();
+
+    auto result = co_await loadKernels(m_provider, self);
+    co_await QCoro::moveToThread(guiThread);
+
+    if (!self) {
+        co_return;
+    }
+
+    if (!result) {
+        qWarning() << "Failed to fetch kernels:" << static_cast<int>(result.error());
+        co_return;
+    }
+
+    auto kernels = std::move(*result);
+    
+    // Only the two cards need KernelData here, list rows are converted by the model
+    KernelData newInUseData;
+    KernelData newRecommendedData;
+    
+    for (const auto& kernel : kernels) {
+        if (kernel.is_in_use()) {
+            newInUseData = KernelData::fromKernel(kernel);
+        } else if (kernel.is_recommended()) {
+            newRecommendedData = KernelData::fromKernel(kernel);
         }
+    }
 
-        m_model.setKernels(kernels_copy);
-    }();
+    bool changed = false;
+    if (m_inUseKernelData != newInUseData) {
+        m_inUseKernelData = newInUseData;
+        changed = true;
+    }
+    if (m_recommendedKernelData != newRecommendedData) {
+        m_recommendedKernelData = newRecommendedData;
+        changed = true;
+    }
+    
+    if (changed) {
+        Q_EMIT kernelsDataChanged();
+    }
+
+    m_model.setKernels(std::move(kernels));
 }
 
 } // namespace mcp::qt::kernel
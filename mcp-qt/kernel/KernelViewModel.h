@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <QCoroTask>
 #include <QObject>
 #include <QtQml>
 
@@ -25,6 +26,8 @@
 
 #include "KernelListModel.h"
 
+#include <memory>
+
 namespace mcp::qt::kernel {
 
 class KernelViewModel : public QObject
@@ -40,6 +43,7 @@ class KernelViewModel : public QObject
 
     Q_PROPERTY(KernelData inUseKernelData READ inUseKernelData NOTIFY kernelsDataChanged)
     Q_PROPERTY(KernelData recommendedKernelData READ recommendedKernelData NOTIFY kernelsDataChanged)
+    Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
 
 public:
     explicit KernelViewModel(KernelListModel &model, QObject *parent = nullptr)
@@ -48,7 +52,7 @@ public:
         init();
     }
 
-    ~KernelViewModel() = default;
+    ~KernelViewModel() override = default;
 
     KernelListModel *model() const;
 
@@ -63,9 +67,12 @@ public:
     KernelData inUseKernelData() const;
     KernelData recommendedKernelData() const;
 
+    bool loading() const;
+
 Q_SIGNALS:
     void currentTransactionKernelNameChanged(QString currentTransactionKernelName);
     void kernelsDataChanged();
+    void loadingChanged(bool loading);
     
     void fetchProgress(int current, int total, QString kernelName);
     
@@ -75,13 +82,22 @@ Q_SIGNALS:
 private:
     void init();
     void fetchAndUpdateKernels();
+    QCoro::Task<void> updateKernels();
+    void setLoading(bool loading);
+
+    // Runs on an io_scheduler thread and owns what it uses, so the view model
+    // may go away mid-fetch. Progress is posted back to self while it lives.
+    static mcp::Task<mcp::kernel::KernelResult<mcp::kernel::KernelVector>>
+    loadKernels(std::shared_ptr<const mcp::kernel::KernelProvider> provider, QPointer<KernelViewModel> self);
 
     KernelListModel &m_model;
-    mcp::kernel::KernelProvider m_provider;
+    std::shared_ptr<const mcp::kernel::KernelProvider> m_provider = std::make_shared<mcp::kernel::KernelProvider>();
 
     mcp::qt::common::TransactionAgentLauncher m_transactionLauncher;
     QString m_currentTransactionKernelName;
     KernelData m_inUseKernelData;
     KernelData m_recommendedKernelData;
+    bool m_loading = false;
+    bool m_fetchPending = false;  // Refresh requested while a fetch was running
 };
 } // namespace mcp::qt::kernel
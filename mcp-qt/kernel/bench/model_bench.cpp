@@ -0,0 +1,150 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * KernelListModel churn benchmark - what a view sees when the kernel list
+ * is reloaded after a transaction.
+ *
+ * A synthetic list of kernels is loaded, then one kernel is installed and
+ * the list is handed to setKernels() again, the way KernelViewModel does
+ * once a transaction finishes. QAbstractItemModelTester checks every
+ * change for consistency, and the row signals are counted. ListView and
+ * QListView only build a delegate for an inserted row or after a reset,
+ * so the delegate count is derived from those two signals.
+ *
+ * A keyed update must touch only the installed kernel: no rows inserted
+ * or removed, no reset. The exit code is non-zero otherwise.
+ *
+ * Usage: mcp-qt-kernel-model-bench [kernels] [runs]
+ */
+
+#include "../KernelListModel.h"
+
+#include <QAbstractItemModelTester>
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+using mcp::kernel::Kernel;
+using mcp::qt::kernel::KernelListModel;
+
+struct Counts {
+    int inserted = 0;
+    int removed = 0;
+    int moved = 0;
+    int changed = 0;
+    int resets = 0;
+    int delegates = 0;
+};
+
+std::vector<Kernel> makeKernels(int count)
+{
+    std::vector<Kernel> kernels;
+    kernels.reserve(static_cast<size_t>(count));
+
+    for (int i = 0; i < count; ++i) {
+        Kernel kernel;
+        kernel.version = {.major = 6, .minor = i, .patch = "1"};
+        kernel.package_name = "linux6" + std::to_string(i);
+        kernel.flags.lts = i % 4 == 0;
+        kernel.flags.installed = i == count - 1;
+        kernel.flags.in_use = i == count - 1;
+        kernel.flags.real_time = i % 7 == 0;
+        kernel.repo = "core";
+        kernel.available_version = kernel.version.to_string();
+        kernels.push_back(std::move(kernel));
+    }
+
+    return kernels;
+}
+
+// The list as reloaded once the oldest kernel has been installed
+std::vector<Kernel> afterInstall(std::vector<Kernel> kernels)
+{
+    kernels.front().flags.installed = true;
+    kernels.front().installed_version = kernels.front().available_version;
+    return kernels;
+}
+
+void track(KernelListModel& model, Counts& counts)
+{
+    QObject::connect(&model, &QAbstractItemModel::rowsInserted, &model,
+                     [&counts](const QModelIndex&, int first, int last) {
+                         counts.inserted += last - first + 1;
+                         counts.delegates += last - first + 1;
+                     });
+    QObject::connect(&model, &QAbstractItemModel::rowsRemoved, &model,
+                     [&counts](const QModelIndex&, int first, int last) {
+                         counts.removed += last - first + 1;
+                     });
+    QObject::connect(&model, &QAbstractItemModel::rowsMoved, &model,
+                     [&counts](const QModelIndex&, int first, int last) {
+                         counts.moved += last - first + 1;
+                     });
+    QObject::connect(&model, &QAbstractItemModel::dataChanged, &model,
+                     [&counts](const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+                         counts.changed += bottomRight.row() - topLeft.row() + 1;
+                     });
+    QObject::connect(&model, &QAbstractItemModel::modelReset, &model,
+                     [&counts, &model] {
+                         ++counts.resets;
+                         counts.delegates += model.rowCount({});
+                     });
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    const int count = argc > 1 ? std::max(2, std::atoi(argv[1])) : 40;
+    const int repeat = argc > 2 ? std::max(1, std::atoi(argv[2])) : 200;
+
+    const auto before = makeKernels(count);
+    const auto after = afterInstall(before);
+
+    std::printf("Reloading %d kernels after an install (%d runs)\n", count, repeat);
+
+    // One checked pass, the tester aborts on an inconsistent change
+    KernelListModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::Fatal);
+    model.setKernels(before);
+
+    Counts counts;
+    track(model, counts);
+    model.setKernels(after);
+
+    std::printf("  rows inserted  %d\n", counts.inserted);
+    std::printf("  rows removed   %d\n", counts.removed);
+    std::printf("  rows moved     %d\n", counts.moved);
+    std::printf("  rows changed   %d\n", counts.changed);
+    std::printf("  resets         %d\n", counts.resets);
+    std::printf("  delegates      %d\n", counts.delegates);
+
+    // Timing without the tester, it re-reads the whole model on every signal
+    std::chrono::steady_clock::duration elapsed{};
+    for (int i = 0; i < repeat; ++i) {
+        KernelListModel timed;
+        timed.setKernels(before);
+
+        const auto start = std::chrono::steady_clock::now();
+        timed.setKernels(after);
+        elapsed += std::chrono::steady_clock::now() - start;
+    }
+    std::printf("  setKernels     %9.3f ms\n",
+                std::chrono::duration<double, std::milli>(elapsed / repeat).count());
+
+    return counts.inserted == 0 && counts.removed == 0 && counts.resets == 0 ? 0 : 1;
+}
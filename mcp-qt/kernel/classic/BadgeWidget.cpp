@@ -16,20 +16,20 @@
 namespace mcp::qt::kernel {
 
 namespace {
-    struct BadgeColors {
-        std::string_view bg;
-        std::string_view border;
-        std::string_view text;
+    const std::unordered_map<BadgeWidget::Type, BadgeWidget::Colors> colorSchemes = {
+        {BadgeWidget::LTS,          {QColor(233, 117, 23), QColor(0xe97517u)}},
+        {BadgeWidget::RealTime,     {QColor(52, 152, 219), QColor(0x3498dbu)}},
+        {BadgeWidget::Installed,    {QColor(60, 118, 61), QColor(0x3c763du)}},
+        {BadgeWidget::Running,      {QColor(60, 118, 61), QColor(0x3c763du)}},
+        {BadgeWidget::EOL,          {QColor(231, 76, 60), QColor(0xe74c3cu)}},
+        {BadgeWidget::Experimental, {QColor(241, 196, 15), QColor(0xf39c12u)}},
     };
 
-    const std::unordered_map<BadgeWidget::Type, BadgeColors> colorSchemes = {
-        {BadgeWidget::LTS,          {"rgba(233, 117, 23, 0.15)", "rgba(233, 117, 23, 0.3)", "#e97517"}},
-        {BadgeWidget::RealTime,     {"rgba(52, 152, 219, 0.15)", "rgba(52, 152, 219, 0.3)", "#3498db"}},
-        {BadgeWidget::Installed,    {"rgba(60, 118, 61, 0.15)", "rgba(60, 118, 61, 0.3)", "#3c763d"}},
-        {BadgeWidget::Running,      {"rgba(60, 118, 61, 0.15)", "rgba(60, 118, 61, 0.3)", "#3c763d"}},
-        {BadgeWidget::EOL,          {"rgba(231, 76, 60, 0.15)", "rgba(231, 76, 60, 0.3)", "#e74c3c"}},
-        {BadgeWidget::Experimental, {"rgba(241, 196, 15, 0.15)", "rgba(241, 196, 15, 0.3)", "#f39c12"}},
-    };
+    QString rgba(const QColor& color, double alpha)
+    {
+        return QStringLiteral("rgba(%1, %2, %3, %4)")
+            .arg(color.red()).arg(color.green()).arg(color.blue()).arg(alpha);
+    }
 }
 
 BadgeWidget::BadgeWidget(QWidget* parent)
@@ -52,6 +52,11 @@ void BadgeWidget::setType(Type type)
     applyStyle();
 }
 
+BadgeWidget::Colors BadgeWidget::colors(Type type)
+{
+    return colorSchemes.at(type);
+}
+
 void BadgeWidget::applyStyle()
 {
     const auto& colors = colorSchemes.at(m_type);
@@ -67,9 +72,7 @@ void BadgeWidget::applyStyle()
         "  font-size: 9pt;"
         "  text-transform: uppercase;"
         "}"))
-    .arg(QString::fromUtf8(colors.bg.data(), static_cast<qsizetype>(colors.bg.size())), 
-         QString::fromUtf8(colors.border.data(), static_cast<qsizetype>(colors.border.size())), 
-         QString::fromUtf8(colors.text.data(), static_cast<qsizetype>(colors.text.size()))));
+    .arg(rgba(colors.accent, 0.15), rgba(colors.accent, 0.3), colors.text.name()));
     
     setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
 }
@@ -5,6 +5,7 @@
  */
 #pragma once
 
+#include <QColor>
 #include <QLabel>
 
 /*
@@ -29,6 +30,12 @@ public:
     };
     Q_ENUM(Type)
 
+    // Background and border are the accent at low opacity
+    struct Colors {
+        QColor accent;
+        QColor text;
+    };
+
     explicit BadgeWidget(QWidget* parent = nullptr);
     BadgeWidget(const QString& text, Type type, QWidget* parent = nullptr);
     ~BadgeWidget() override = default;
@@ -36,6 +43,9 @@ public:
     void setType(Type type);
     Type type() const { return m_type; }
 
+    // Shared with painted badges in KernelItemDelegate
+    static Colors colors(Type type);
+
 private:
     void applyStyle();
 
@@ -0,0 +1,346 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "KernelItemDelegate.h"
+#include "KernelItemWidget.h"
+#include "../KernelListModel.h"
+
+#include <QApplication>
+#include <QIcon>
+#include <QPainter>
+#include <QStyleOptionButton>
+
+#include <algorithm>
+
+/*
+ * Kernel list delegate.
+ * Geometry mirrors KernelItemWidget in ListItem mode so that the hover
+ * editor lines up with the painted row underneath it.
+ */
+
+namespace mcp::qt::kernel {
+
+namespace {
+    constexpr int c_hMargin = 12;
+    constexpr int c_vMargin = 6;
+    constexpr int c_lineSpacing = 4;
+    constexpr int c_badgeSpacing = 6;
+    constexpr int c_titleSpacing = 8;
+    constexpr int c_minRowHeight = 50;
+    constexpr int c_minActionWidth = 90;
+
+    // Header label margins as in the old widget list: 12 above, 6 below
+    constexpr int c_headerTop = 12;
+    constexpr int c_headerBottom = 6;
+    constexpr int c_separatorHeight = 2;
+
+    const QColor c_linkColor(0x2980b9u);
+
+    QFont titleFont(const QFont& base)
+    {
+        QFont font = base;
+        font.setPointSize(11);
+        font.setBold(true);
+        return font;
+    }
+
+    QFont infoFont(const QFont& base)
+    {
+        QFont font = base;
+        font.setPointSize(9);
+        return font;
+    }
+
+    QFont headerFont(const QFont& base)
+    {
+        QFont font = base;
+        font.setBold(true);
+        return font;
+    }
+
+    const QStyle* styleFor(const QStyleOptionViewItem& option)
+    {
+        return option.widget ? option.widget->style() : QApplication::style();
+    }
+
+    QStyleOptionButton buttonOption(const QStyleOptionViewItem& option, const QString& text)
+    {
+        QStyleOptionButton button;
+        button.palette = option.palette;
+        button.fontMetrics = option.fontMetrics;
+        button.direction = option.direction;
+        button.text = text;
+        return button;
+    }
+}
+
+KernelItemDelegate::KernelItemDelegate(QObject* parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+bool KernelItemDelegate::startsSection(const QModelIndex& index)
+{
+    if (index.row() == 0) {
+        return true;
+    }
+    const QModelIndex previous = index.siblingAtRow(index.row() - 1);
+    return previous.data(KernelListModel::Category) != index.data(KernelListModel::Category);
+}
+
+int KernelItemDelegate::rowInSection(const QModelIndex& index)
+{
+    // Sections are a handful of rows, walking back is cheaper than caching
+    const QVariant category = index.data(KernelListModel::Category);
+    int row = index.row();
+    while (row > 0 && index.siblingAtRow(row - 1).data(KernelListModel::Category) == category) {
+        --row;
+    }
+    return index.row() - row;
+}
+
+int KernelItemDelegate::headerHeight(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    if (!startsSection(index)) {
+        return 0;
+    }
+
+    const int separator = index.row() > 0 ? c_separatorHeight : 0;
+    return separator + c_headerTop + QFontMetrics(headerFont(option.font)).height() + c_headerBottom;
+}
+
+QFont KernelItemDelegate::badgeFont(const QFont& base)
+{
+    QFont font = base;
+    font.setPointSize(9);
+    font.setBold(true);
+    font.setCapitalization(QFont::AllUppercase);
+    return font;
+}
+
+QSize KernelItemDelegate::badgeSize(const Badge& badge, const QFont& font)
+{
+    // Same padding as the BadgeWidget stylesheet: 2px 8px plus a 1px border
+    const QFontMetrics fm(badgeFont(font));
+    return {fm.horizontalAdvance(badge.text) + 2 * 8 + 2, fm.height() + 2 * 2 + 2};
+}
+
+int KernelItemDelegate::paintBadge(QPainter* painter, const QPoint& topLeft, int height, const Badge& badge,
+                                   const QFont& font)
+{
+    const auto colors = BadgeWidget::colors(badge.type);
+    const QSize size = badgeSize(badge, font);
+    const QRectF rect(QPointF(topLeft) + QPointF(0.5, (height - size.height()) / 2.0 + 0.5),
+                      QSizeF(size) - QSizeF(1, 1));
+
+    QColor background = colors.accent;
+    background.setAlphaF(0.15f);
+    QColor border = colors.accent;
+    border.setAlphaF(0.3f);
+
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setPen(border);
+    painter->setBrush(background);
+    painter->drawRoundedRect(rect, 4, 4);
+
+    painter->setFont(badgeFont(font));
+    painter->setPen(colors.text);
+    painter->drawText(rect, Qt::AlignCenter, badge.text);
+
+    return size.width();
+}
+
+QString KernelItemDelegate::actionText(const QModelIndex& index) const
+{
+    if (index.data(KernelListModel::IsInUse).toBool()) {
+        return tr("Running");
+    }
+    return index.data(KernelListModel::IsInstalled).toBool() ? tr("Remove") : tr("Install");
+}
+
+QRect KernelItemDelegate::actionRect(const QStyleOptionViewItem& option, const QRect& row,
+                                     const QModelIndex& index) const
+{
+    const QStyleOptionButton button = buttonOption(option, actionText(index));
+
+    const QSize textSize = option.fontMetrics.size(Qt::TextShowMnemonic, button.text);
+    const int iconExtent = styleFor(option)->pixelMetric(QStyle::PM_SmallIconSize, nullptr, option.widget);
+    const QSize contents(textSize.width() + iconExtent + 4, std::max(textSize.height(), iconExtent));
+    const QSize size = styleFor(option)->sizeFromContents(QStyle::CT_PushButton, &button, contents, option.widget);
+
+    const int width = std::max(c_minActionWidth, size.width());
+    return {row.right() - c_hMargin - width + 1, row.top() + (row.height() - size.height()) / 2,
+            width, size.height()};
+}
+
+void KernelItemDelegate::paintHeader(QPainter* painter, const QStyleOptionViewItem& option, const QRect& rect,
+                                     const QModelIndex& index) const
+{
+    int top = rect.top();
+
+    // Sunken separator between sections
+    if (index.row() > 0) {
+        painter->setPen(option.palette.color(QPalette::Mid));
+        painter->drawLine(rect.left(), top, rect.right(), top);
+        painter->setPen(option.palette.color(QPalette::Light));
+        painter->drawLine(rect.left(), top + 1, rect.right(), top + 1);
+        top += c_separatorHeight;
+    }
+
+    const QRect textRect(rect.left() + c_hMargin, top + c_headerTop,
+                         rect.width() - 2 * c_hMargin, rect.bottom() - top - c_headerTop - c_headerBottom + 1);
+
+    painter->setFont(headerFont(option.font));
+    painter->setPen(option.palette.color(QPalette::WindowText));
+    painter->drawText(textRect, Qt::AlignLeft | Qt::AlignVCenter,
+                      index.data(KernelListModel::Category).toString());
+}
+
+void KernelItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    painter->save();
+
+    const int header = headerHeight(option, index);
+    if (header > 0) {
+        paintHeader(painter, option, option.rect.adjusted(0, 0, 0, header - option.rect.height()), index);
+    }
+
+    const QRect row = option.rect.adjusted(0, header, 0, 0);
+
+    // Zebra striping per section
+    painter->fillRect(row, rowInSection(index) % 2 == 1 ? option.palette.alternateBase() : option.palette.window());
+
+    const bool inUse = index.data(KernelListModel::IsInUse).toBool();
+    const bool installed = index.data(KernelListModel::IsInstalled).toBool();
+
+    // Action button, right-aligned
+    QStyleOptionButton button = buttonOption(option, actionText(index));
+    button.rect = actionRect(option, row, index);
+    button.state = QStyle::State_Raised;
+    if (!inUse) {
+        button.state |= QStyle::State_Enabled;
+        button.icon = QIcon::fromTheme(installed ? QStringLiteral("edit-delete") : QStringLiteral("download"));
+        const int iconExtent = styleFor(option)->pixelMetric(QStyle::PM_SmallIconSize, nullptr, option.widget);
+        button.iconSize = QSize(iconExtent, iconExtent);
+    }
+    styleFor(option)->drawControl(QStyle::CE_PushButton, &button, painter, option.widget);
+
+    // Status badges, right to left before the button
+    QList<Badge> statusBadges;
+    if (index.data(KernelListModel::IsEOL).toBool()) {
+        statusBadges.append({tr("Unsupported"), BadgeWidget::EOL});
+    }
+    if (index.data(KernelListModel::IsExperimental).toBool()) {
+        statusBadges.append({tr("Experimental"), BadgeWidget::Experimental});
+    }
+
+    int statusLeft = button.rect.left() - c_badgeSpacing;
+    for (const auto& badge : statusBadges) {
+        statusLeft -= badgeSize(badge, option.font).width();
+    }
+    statusLeft -= c_badgeSpacing * static_cast<int>(std::max<qsizetype>(statusBadges.size() - 1, 0));
+
+    int x = statusLeft;
+    for (const auto& badge : statusBadges) {
+        x += paintBadge(painter, QPoint(x, row.top()), row.height(), badge, option.font) + c_badgeSpacing;
+    }
+
+    // Title line and package info, vertically centered as a block
+    const QFontMetrics titleMetrics(titleFont(option.font));
+    const QFontMetrics infoMetrics(infoFont(option.font));
+    const int blockHeight = titleMetrics.height() + c_lineSpacing + infoMetrics.height();
+    const int textLeft = row.left() + c_hMargin;
+    const int textRight = statusLeft - c_badgeSpacing;
+    const int titleTop = row.top() + (row.height() - blockHeight) / 2;
+
+    const QString title = titleMetrics.elidedText(
+        QStringLiteral("Linux ") + index.data(KernelListModel::Version).toString(), Qt::ElideRight,
+        textRight - textLeft);
+    const QRect titleRect(textLeft, titleTop, titleMetrics.horizontalAdvance(title), titleMetrics.height());
+
+    painter->setFont(titleFont(option.font));
+    painter->setPen(option.palette.color(QPalette::WindowText));
+    painter->drawText(titleRect, Qt::AlignLeft | Qt::AlignVCenter, title);
+
+    x = titleRect.right() + 1 + c_titleSpacing;
+    if (index.data(KernelListModel::IsRealTime).toBool()) {
+        x += paintBadge(painter, QPoint(x, titleTop), titleMetrics.height(), {tr("RT"), BadgeWidget::RealTime},
+                        option.font) + c_badgeSpacing;
+    }
+    if (index.data(KernelListModel::IsLTS).toBool()) {
+        paintBadge(painter, QPoint(x, titleTop), titleMetrics.height(), {tr("LTS"), BadgeWidget::LTS}, option.font);
+    }
+
+    const QRect infoRect(textLeft, titleTop + titleMetrics.height() + c_lineSpacing,
+                         std::max(0, textRight - textLeft), infoMetrics.height());
+    const QString name = index.data(KernelListModel::Name).toString();
+
+    painter->setFont(infoFont(option.font));
+    painter->drawText(infoRect, Qt::AlignLeft | Qt::AlignVCenter, name);
+
+    if (!index.data(KernelListModel::ChangelogUrl).toString().isEmpty()) {
+        const QString separator = QStringLiteral(" • ");
+        const int linkLeft = infoRect.left() + infoMetrics.horizontalAdvance(name + separator);
+
+        painter->drawText(infoRect.adjusted(infoMetrics.horizontalAdvance(name), 0, 0, 0),
+                          Qt::AlignLeft | Qt::AlignVCenter, separator);
+        painter->setPen(c_linkColor);
+        painter->drawText(QRect(linkLeft, infoRect.top(), std::max(0, infoRect.right() - linkLeft + 1),
+                                infoRect.height()),
+                          Qt::AlignLeft | Qt::AlignVCenter, tr("Changelog") + QStringLiteral(" ↗"));
+    }
+
+    painter->restore();
+}
+
+QSize KernelItemDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    const int text = QFontMetrics(titleFont(option.font)).height() + c_lineSpacing
+                   + QFontMetrics(infoFont(option.font)).height();
+    const int button = actionRect(option, QRect(0, 0, 0, 0), index).height();
+    const int row = std::max({c_minRowHeight, text + 2 * c_vMargin, button + 2 * c_vMargin});
+
+    return {option.rect.width(), headerHeight(option, index) + row};
+}
+
+QWidget* KernelItemDelegate::createEditor(QWidget* parent, [[maybe_unused]] const QStyleOptionViewItem& option,
+                                          [[maybe_unused]] const QModelIndex& index) const
+{
+    auto* editor = new KernelItemWidget(KernelItemWidget::ListItem, parent);
+    editor->setMinimumSize(0, 0);
+
+    connect(editor, &KernelItemWidget::installClicked, this, &KernelItemDelegate::installClicked);
+    connect(editor, &KernelItemWidget::removeClicked, this, &KernelItemDelegate::removeClicked);
+    connect(editor, &KernelItemWidget::changelogClicked, this, &KernelItemDelegate::changelogClicked);
+
+    return editor;
+}
+
+void KernelItemDelegate::setEditorData(QWidget* editor, const QModelIndex& index) const
+{
+    auto* item = qobject_cast<KernelItemWidget*>(editor);
+    if (!item) {
+        return;
+    }
+
+    // One lookup of the row's cached value instead of a map built per role
+    item->setKernelData(index.data(KernelListModel::KernelData).value<KernelData>());
+    item->setAlternateBackground(rowInSection(index) % 2 == 1);
+}
+
+void KernelItemDelegate::setModelData([[maybe_unused]] QWidget* editor, [[maybe_unused]] QAbstractItemModel* model,
+                                      [[maybe_unused]] const QModelIndex& index) const
+{
+    // Rows are read-only, editors only host the action button and changelog link
+}
+
+void KernelItemDelegate::updateEditorGeometry(QWidget* editor, const QStyleOptionViewItem& option,
+                                              const QModelIndex& index) const
+{
+    editor->setGeometry(option.rect.adjusted(0, headerHeight(option, index), 0, 0));
+}
+
+} // namespace mcp::qt::kernel
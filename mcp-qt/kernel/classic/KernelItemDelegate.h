@@ -0,0 +1,64 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ */
+#pragma once
+
+#include "BadgeWidget.h"
+#include "../KernelData.h"
+
+#include <QStyledItemDelegate>
+
+/*
+ * Paints KernelListModel rows the way KernelItemWidget lays them out.
+ * Section headers are drawn above the first row of each category.
+ * Real widgets exist only as editors, which KernelPage opens on hover.
+ */
+
+namespace mcp::qt::kernel {
+
+class KernelItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit KernelItemDelegate(QObject* parent = nullptr);
+    ~KernelItemDelegate() override = default;
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+    QWidget* createEditor(QWidget* parent, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    void setEditorData(QWidget* editor, const QModelIndex& index) const override;
+    void setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const override;
+    void updateEditorGeometry(QWidget* editor, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+Q_SIGNALS:
+    void installClicked(const KernelData& kernelData);
+    void removeClicked(const KernelData& kernelData);
+    void changelogClicked(const QString& changelogUrl);
+
+private:
+    struct Badge {
+        QString text;
+        BadgeWidget::Type type;
+    };
+
+    // Height of the category header painted above the row, 0 inside a section
+    int headerHeight(const QStyleOptionViewItem& option, const QModelIndex& index) const;
+    static bool startsSection(const QModelIndex& index);
+    static int rowInSection(const QModelIndex& index);
+
+    void paintHeader(QPainter* painter, const QStyleOptionViewItem& option, const QRect& rect,
+                     const QModelIndex& index) const;
+    static int paintBadge(QPainter* painter, const QPoint& topLeft, int height, const Badge& badge,
+                          const QFont& font);
+    static QSize badgeSize(const Badge& badge, const QFont& font);
+    static QFont badgeFont(const QFont& base);
+
+    QString actionText(const QModelIndex& index) const;
+    QRect actionRect(const QStyleOptionViewItem& option, const QRect& row, const QModelIndex& index) const;
+};
+
+} // namespace mcp::qt::kernel
@@ -102,26 +102,9 @@ void KernelItemWidget::setKernelData(const KernelData& data)
     m_isInstalled = data.isInstalled;
     m_isInUse = data.isInUse;
     m_isLTS = data.isLTS;
-    m_isRealTime = false;  // Not in KernelData, handled separately by list model
-    m_isEOL = false;       // Not in KernelData, handled separately by list model
-    m_isExperimental = false; // Not in KernelData, handled separately by list model
-    
-    updateDisplay();
-}
-
-void KernelItemWidget::setKernelData(const QVariantMap& data)
-{
-    m_name = data.value(QStringLiteral("name")).toString();
-    m_version = data.value(QStringLiteral("version")).toString();
-    m_changelogUrl = data.value(QStringLiteral("changelogUrl")).toString();
-    m_extraModules = data.value(QStringLiteral("extraModules")).toStringList();
-    
-    m_isInstalled = data.value(QStringLiteral("isInstalled")).toBool();
-    m_isInUse = data.value(QStringLiteral("isInUse")).toBool();
-    m_isLTS = data.value(QStringLiteral("isLTS")).toBool();
-    m_isRealTime = data.value(QStringLiteral("isRealTime")).toBool();
-    m_isEOL = data.value(QStringLiteral("isEOL")).toBool();
-    m_isExperimental = data.value(QStringLiteral("isExperimental")).toBool();
+    m_isRealTime = data.isRealTime;
+    m_isEOL = data.isEOL;
+    m_isExperimental = data.isExperimental;
     
     updateDisplay();
 }
@@ -218,6 +201,9 @@ KernelData KernelItemWidget::getKernelData() const
     data.isInstalled = m_isInstalled;
     data.isInUse = m_isInUse;
     data.isLTS = m_isLTS;
+    data.isRealTime = m_isRealTime;
+    data.isEOL = m_isEOL;
+    data.isExperimental = m_isExperimental;
     return data;
 }
 
@@ -13,7 +13,6 @@
 #include <QPushButton>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
-#include <QVariantMap>
 
 /*
  * Unified kernel item widget used for both card display and list rows.
@@ -33,7 +32,6 @@ public:
     ~KernelItemWidget() override = default;
 
     void setKernelData(const KernelData& data);
-    void setKernelData(const QVariantMap& data);
     void setAlternateBackground(bool alternate);
     
     QString kernelName() const { return m_name; }
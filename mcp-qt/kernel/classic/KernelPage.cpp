@@ -9,16 +9,17 @@
 #include "../KernelListModel.h"
 
 #include <QAbstractItemModel>
+#include <QDebug>
 #include <QDesktopServices>
 #include <QFrame>
 #include <QMessageBox>
-#include <QScrollArea>
 #include <QUrl>
 
 /*
  * Main kernel manager page.
- * Uses KernelItemWidget in Card mode for top section,
- * and ListItem mode for the scrollable kernel list.
+ * Uses KernelItemWidget in Card mode for top section.
+ * The kernel list is painted by KernelItemDelegate; a ListItem mode
+ * KernelItemWidget is opened as editor for the hovered row only.
  */
 
 namespace mcp::qt::kernel {
@@ -30,6 +31,7 @@ KernelPage::KernelPage(KernelViewModel* viewModel, QWidget* parent)
     setupUi();
     setupConnections();
     onKernelsDataChanged();
+    onLoadingChanged(m_viewModel->loading());
 }
 
 void KernelPage::setupUi()
@@ -64,30 +66,59 @@ void KernelPage::setupUi()
     separator->setFrameShadow(QFrame::Sunken);
     mainLayout->addWidget(separator);
     
-    auto* scrollArea = new QScrollArea(this);
-    scrollArea->setWidgetResizable(true);
-    scrollArea->setFrameShape(QFrame::StyledPanel);
-    scrollArea->setProperty("_breeze_force_frame", true);
-
+    m_loadingBar = new QProgressBar(this);
+    m_loadingBar->setTextVisible(true);
+    mainLayout->addWidget(m_loadingBar);
+    
+    m_kernelDelegate = new KernelItemDelegate(this);
     
-    auto* scrollContent = new QWidget(scrollArea);
-    m_kernelListLayout = new QVBoxLayout(scrollContent);
-    m_kernelListLayout->setContentsMargins(0, 0, 0, 0);
-    m_kernelListLayout->setSpacing(0);
+    m_kernelList = new QListView(this);
+    m_kernelList->setModel(m_viewModel->model());
+    m_kernelList->setItemDelegate(m_kernelDelegate);
+    m_kernelList->setSelectionMode(QAbstractItemView::NoSelection);
+    m_kernelList->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_kernelList->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    m_kernelList->setMouseTracking(true);
+    m_kernelList->setFrameShape(QFrame::StyledPanel);
+    m_kernelList->setProperty("_breeze_force_frame", true);
+    m_kernelList->viewport()->setBackgroundRole(QPalette::Window);
     
-    scrollArea->setWidget(scrollContent);
-    mainLayout->addWidget(scrollArea, 1);
+    // First screenful is painted before the rest of the list has been measured
+    m_kernelList->setLayoutMode(QListView::Batched);
+    m_kernelList->setBatchSize(20);
+    
+    mainLayout->addWidget(m_kernelList, 1);
 }
 
 void KernelPage::setupConnections()
 {
     connect(m_viewModel, &KernelViewModel::kernelsDataChanged,
             this, &KernelPage::onKernelsDataChanged);
+    connect(m_viewModel, &KernelViewModel::loadingChanged,
+            this, &KernelPage::onLoadingChanged);
+    connect(m_viewModel, &KernelViewModel::fetchProgress,
+            this, &KernelPage::onFetchProgress);
+    
+    connect(m_kernelList, &QAbstractItemView::entered, this, &KernelPage::onRowEntered);
+    connect(m_kernelList, &QAbstractItemView::viewportEntered, this, [this]() {
+        onRowEntered(QModelIndex());
+    });
+    
+    // The view does not refresh persistent editors on dataChanged
+    connect(m_viewModel->model(), &QAbstractItemModel::dataChanged, this,
+            [this](const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+        if (m_hoveredRow.isValid()
+            && m_hoveredRow.row() >= topLeft.row() && m_hoveredRow.row() <= bottomRight.row()) {
+            m_kernelDelegate->setEditorData(m_kernelList->indexWidget(m_hoveredRow), m_hoveredRow);
+        }
+    });
     
-    connect(m_viewModel->model(), &QAbstractItemModel::modelReset,
-            this, &KernelPage::populateKernelList);
-    connect(m_viewModel->model(), &QAbstractItemModel::rowsInserted,
-            this, &KernelPage::populateKernelList);
+    connect(m_kernelDelegate, &KernelItemDelegate::installClicked,
+            this, &KernelPage::onInstallClicked);
+    connect(m_kernelDelegate, &KernelItemDelegate::removeClicked,
+            this, &KernelPage::onRemoveClicked);
+    connect(m_kernelDelegate, &KernelItemDelegate::changelogClicked,
+            this, &KernelPage::onChangelogClicked);
     
     connect(m_inUseCard, &KernelItemWidget::installClicked,
             this, &KernelPage::onInstallClicked);
@@ -129,96 +160,39 @@ void KernelPage::onKernelsDataChanged()
         m_recommendedCard->setVisible(false);
         m_recommendedLabel->setVisible(false);
     }
-    
-    populateKernelList();
 }
 
-void KernelPage::populateKernelList()
+void KernelPage::onLoadingChanged(bool loading)
+{
+    // Busy until the first progress report gives a total
+    m_loadingBar->setRange(0, 0);
+    m_loadingBar->setFormat(tr("Loading kernels..."));
+    m_loadingBar->setVisible(loading);
+}
+
+void KernelPage::onFetchProgress(int current, int total, const QString& kernelName)
 {
-    for (auto* item : m_listItems) {
-        m_kernelListLayout->removeWidget(item);
-        delete item;
+    if (total <= 0 || current >= total) {
+        return;
     }
-    m_listItems.clear();
-    
-    for (auto* header : m_sectionHeaders) {
-        m_kernelListLayout->removeWidget(header);
-        delete header;
+    m_loadingBar->setRange(0, total);
+    m_loadingBar->setValue(current);
+    m_loadingBar->setFormat(tr("Loading kernel metadata: %1 / %2 (%3)").arg(current).arg(total).arg(kernelName));
+}
+
+void KernelPage::onRowEntered(const QModelIndex& index)
+{
+    if (index == m_hoveredRow) {
+        return;
     }
-    m_sectionHeaders.clear();
     
-    for (auto* separator : m_sectionSeparators) {
-        m_kernelListLayout->removeWidget(separator);
-        delete separator;
+    if (m_hoveredRow.isValid()) {
+        m_kernelList->closePersistentEditor(m_hoveredRow);
     }
-    m_sectionSeparators.clear();
-    
-    QLayoutItem* stretch = m_kernelListLayout->takeAt(m_kernelListLayout->count() - 1);
-    if (stretch) delete stretch;
-    
-    KernelListModel* model = m_viewModel->model();
-    
-    // Model already returns items sorted by category (In use, Installed, LTS, Other)
-    // so we just iterate in order and add section headers when category changes
-    QString currentCategory;
-    int itemIndexInSection = 0;
-    
-    for (int row = 0; row < model->rowCount(QModelIndex()); ++row) {
-        QModelIndex idx = model->index(row, 0);
-        
-        QString category = model->data(idx, KernelListModel::Category).toString();
-        if (category != currentCategory) {
-            if (!currentCategory.isEmpty()) {
-                auto* separator = new QFrame(this);
-                separator->setFrameShape(QFrame::HLine);
-                separator->setFrameShadow(QFrame::Sunken);
-                m_kernelListLayout->addWidget(separator);
-                m_sectionSeparators.append(separator);
-            }
-            
-            currentCategory = category;
-            itemIndexInSection = 0;
-            
-            auto* header = new QLabel(category, this);
-            QFont headerFont = header->font();
-            headerFont.setBold(true);
-            header->setFont(headerFont);
-            header->setContentsMargins(12, 12, 12, 6);
-            m_kernelListLayout->addWidget(header);
-            m_sectionHeaders.append(header);
-        }
-        
-        QVariantMap data;
-        data[QStringLiteral("name")] = model->data(idx, KernelListModel::Name);
-        data[QStringLiteral("version")] = model->data(idx, KernelListModel::Version);
-        data[QStringLiteral("changelogUrl")] = model->data(idx, KernelListModel::ChangelogUrl);
-        data[QStringLiteral("extraModules")] = model->data(idx, KernelListModel::ExtraModules);
-        data[QStringLiteral("isInstalled")] = model->data(idx, KernelListModel::IsInstalled);
-        data[QStringLiteral("isInUse")] = model->data(idx, KernelListModel::IsInUse);
-        data[QStringLiteral("isLTS")] = model->data(idx, KernelListModel::IsLTS);
-        data[QStringLiteral("isRealTime")] = model->data(idx, KernelListModel::IsRealTime);
-        data[QStringLiteral("isEOL")] = model->data(idx, KernelListModel::IsEOL);
-        data[QStringLiteral("isExperimental")] = model->data(idx, KernelListModel::IsExperimental);
-        
-        auto* item = new KernelItemWidget(KernelItemWidget::ListItem, this);
-        item->setKernelData(data);
-        
-        // Zebra striping per section
-        item->setAlternateBackground(itemIndexInSection % 2 == 1);
-        itemIndexInSection++;
-        
-        connect(item, &KernelItemWidget::installClicked,
-                this, &KernelPage::onInstallClicked);
-        connect(item, &KernelItemWidget::removeClicked,
-                this, &KernelPage::onRemoveClicked);
-        connect(item, &KernelItemWidget::changelogClicked,
-                this, &KernelPage::onChangelogClicked);
-        
-        m_kernelListLayout->addWidget(item);
-        m_listItems.append(item);
+    m_hoveredRow = index;
+    if (m_hoveredRow.isValid()) {
+        m_kernelList->openPersistentEditor(m_hoveredRow);
     }
-    
-    m_kernelListLayout->addStretch();
 }
 
 void KernelPage::onInstallClicked(const KernelData& kernelData)
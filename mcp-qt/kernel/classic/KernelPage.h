@@ -5,19 +5,22 @@
  */
 #pragma once
 
+#include "KernelItemDelegate.h"
 #include "KernelItemWidget.h"
 #include "../KernelViewModel.h"
 
 #include <QWidget>
 #include <QFrame>
 #include <QLabel>
-#include <QScrollArea>
+#include <QListView>
+#include <QPersistentModelIndex>
+#include <QProgressBar>
 #include <QVBoxLayout>
 
 /*
  * Main kernel manager page widget.
  * Top section: Current/Recommended kernel cards.
- * Bottom section: Scrollable list of all kernels.
+ * Bottom section: List view of all kernels, painted by KernelItemDelegate.
  */
 
 namespace mcp::qt::kernel {
@@ -32,7 +35,9 @@ public:
 
 private Q_SLOTS:
     void onKernelsDataChanged();
-    void populateKernelList();
+    void onLoadingChanged(bool loading);
+    void onFetchProgress(int current, int total, const QString& kernelName);
+    void onRowEntered(const QModelIndex& index);
     void onInstallClicked(const KernelData& kernelData);
     void onRemoveClicked(const KernelData& kernelData);
     void onChangelogClicked(const QString& changelogUrl);
@@ -52,11 +57,13 @@ private:
     QLabel* m_recommendedLabel;
     KernelItemWidget* m_recommendedCard;
     
-    // Kernel list
-    QVBoxLayout* m_kernelListLayout;
-    QList<KernelItemWidget*> m_listItems;
-    QList<QLabel*> m_sectionHeaders;
-    QList<QFrame*> m_sectionSeparators;
+    // Shown while the catalog is fetched off the GUI thread
+    QProgressBar* m_loadingBar;
+    
+    // Kernel list, only the hovered row has a real widget
+    QListView* m_kernelList;
+    KernelItemDelegate* m_kernelDelegate;
+    QPersistentModelIndex m_hoveredRow;
 };
 
 } // namespace mcp::qt::kernel
@@ -15,6 +15,10 @@
 #include <QIcon>
 #include <QMessageBox>
 
+#include <StartupTrace.hpp>
+
+#include <optional>
+
 /*
  * Standalone entry point for Classic Qt Widgets Kernel Manager.
  * Provides traditional widget-based UI for lightweight DEs.
@@ -24,6 +28,12 @@ using namespace mcp::qt::kernel;
 
 int main(int argc, char *argv[])
 {
+    // Set MCP_TRACE_STARTUP=<file> to record the phases below
+    mcp::trace::instant("main");
+
+    std::optional<mcp::trace::Scope> phase;
+    phase.emplace("QApplication");
+
     QApplication app(argc, argv);
     app.setApplicationName(QStringLiteral("MCP Kernel Manager"));
     app.setApplicationDisplayName(QObject::tr("Manjaro Kernel Manager"));
@@ -37,9 +47,13 @@ int main(int argc, char *argv[])
     app.setWindowIcon(QIcon::fromTheme(QStringLiteral("preferences-system-linux-kernel"),
                                        QIcon(QStringLiteral(":/images/resources/tux-manjaro.png"))));
 
+    phase.emplace("KernelViewModel");
+
     KernelListModel model;
     KernelViewModel viewModel(model);
 
+    phase.emplace("Main window");
+
     QMainWindow mainWindow;
     mainWindow.setWindowTitle(QObject::tr("Manjaro Kernel Manager"));
     mainWindow.setWindowIcon(app.windowIcon());
@@ -93,6 +107,12 @@ int main(int argc, char *argv[])
     mainWindow.statusBar()->showMessage(QObject::tr("Ready"));
 
     mainWindow.show();
+    phase.reset();
+
+    // Queued behind the expose and paint events of the first show
+    QMetaObject::invokeMethod(&app, []() {
+        mcp::trace::ready("first frame");
+    }, ::Qt::QueuedConnection);
 
     return app.exec();
 }
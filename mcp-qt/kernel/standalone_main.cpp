@@ -14,22 +14,35 @@
 #include "KernelViewModel.h"
 #include "VersionInfo.h"
 
+#include <QDir>
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
 #include <QQuickStyle>
+#include <QQuickWindow>
+
+#include <StartupTrace.hpp>
 
 #include <pamac/database.hpp>
 
+#include <optional>
+
 using namespace mcp::qt::kernel;
 
 int main(int argc, char *argv[])
 {
+    // Set MCP_TRACE_STARTUP=<file> to record the phases below
+    mcp::trace::instant("main");
+
+    std::optional<mcp::trace::Scope> phase;
+    phase.emplace("QGuiApplication");
+
     QGuiApplication app(argc, argv);
     app.setApplicationName(QStringLiteral("MCP Kernel Manager"));
     app.setOrganizationName(QStringLiteral("Manjaro"));
     app.setApplicationVersion(QString::fromLatin1(MCP_VERSION));
    
+    phase.emplace("pamac::Database::initialize");
 
     // Initialize pamac database
     auto status = pamac::Database::initialize("/etc/pamac.conf");
@@ -47,19 +60,39 @@ int main(int argc, char *argv[])
             return new mcp::qt::common::VersionInfo();
         });
 
+    phase.emplace("KernelViewModel");
+
     KernelListModel model;
     KernelViewModel viewModel(model);
 
+    phase.emplace("QML load");
+
     QQmlApplicationEngine engine;
 
+    // Installed modules, with QML_IMPORT_PATH re-added above them in its own
+    // order, so an uninstalled build runs with QML_IMPORT_PATH=<build>/bin
+    engine.addImportPath(QStringLiteral(MCP_QML_INSTALL_DIR));
+    const auto devPaths = qEnvironmentVariable("QML_IMPORT_PATH").split(QDir::listSeparator(), ::Qt::SkipEmptyParts);
+    for (auto it = devPaths.crbegin(); it != devPaths.crend(); ++it) {
+        engine.addImportPath(*it);
+    }
+
     engine.rootContext()->setContextProperty(QStringLiteral("vm"), &viewModel);
 
-    engine.load(QUrl(QStringLiteral("qrc:/kernel-standalone/ui/standalone_main.qml")));
+    engine.loadFromModule("org.manjaro.mcp.kernel", "standalone_main");
 
     if (engine.rootObjects().isEmpty()) {
         qCritical() << QStringLiteral("Failed to load QML");
         return 1;
     }
 
+    phase.reset();
+
+    if (auto* window = qobject_cast<QQuickWindow*>(engine.rootObjects().constFirst())) {
+        QObject::connect(window, &QQuickWindow::frameSwapped, window, []() {
+            mcp::trace::ready("first frame");
+        }, ::Qt::SingleShotConnection);
+    }
+
     return app.exec();
 }
@@ -11,155 +11,188 @@ QQC2.Page {
     // Configuration
     padding: 0
 
-    // Dialogs
-    Kirigami.PromptDialog {
-        id: errorDialog
-        
-        title: qsTr("Error")
-        standardButtons: Kirigami.Dialog.NoButton
-        
-        customFooterActions: [
-            Kirigami.Action {
-                text: qsTr("Close")
-                icon.name: "dialog-close"
-                onTriggered: errorDialog.close()
-            }
-        ]
+    // State
+    readonly property bool dialogOpen: (confirmationDialogLoader.item?.visible ?? false)
+        || (errorDialogLoader.item?.visible ?? false)
+
+    /**
+     * Creates the dialog of a loader on first use
+     * @param {Loader} loader - One of the dialog loaders below
+     * @returns {var} The dialog
+     */
+    function dialog(loader: Loader): var {
+        loader.active = true
+        return loader.item
     }
-    
-    Kirigami.PromptDialog {
-        id: updatesPendingDialog
-        
-        title: qsTr("System Updates Required")
-        subtitle: qsTr("Please upgrade your system before installing new kernels")
-        standardButtons: Kirigami.Dialog.NoButton
-        
-        customFooterActions: [
-            Kirigami.Action {
-                text: qsTr("Close")
-                icon.name: "dialog-close"
-                onTriggered: updatesPendingDialog.close()
-            }
-        ]
-        
-        ColumnLayout {
-            spacing: Kirigami.Units.largeSpacing
-            
-            QQC2.Label {
-                Layout.fillWidth: true
-                wrapMode: Text.WordWrap
-                text: qsTr("Your system has pending updates that must be installed before you can install new kernels.\n\nPlease run system upgrade first using your package manager.")
+
+    // Dialogs, only created once they are needed
+    Loader {
+        id: errorDialogLoader
+
+        active: false
+
+        sourceComponent: Kirigami.PromptDialog {
+            id: errorDialog
+
+            title: qsTr("Error")
+            standardButtons: Kirigami.Dialog.NoButton
+
+            customFooterActions: [
+                Kirigami.Action {
+                    text: qsTr("Close")
+                    icon.name: "dialog-close"
+                    onTriggered: errorDialog.close()
+                }
+            ]
+        }
+    }
+
+    Loader {
+        id: updatesPendingDialogLoader
+
+        active: false
+
+        sourceComponent: Kirigami.PromptDialog {
+            id: updatesPendingDialog
+
+            title: qsTr("System Updates Required")
+            subtitle: qsTr("Please upgrade your system before installing new kernels")
+            standardButtons: Kirigami.Dialog.NoButton
+
+            customFooterActions: [
+                Kirigami.Action {
+                    text: qsTr("Close")
+                    icon.name: "dialog-close"
+                    onTriggered: updatesPendingDialog.close()
+                }
+            ]
+
+            ColumnLayout {
+                spacing: Kirigami.Units.largeSpacing
+
+                QQC2.Label {
+                    Layout.fillWidth: true
+                    wrapMode: Text.WordWrap
+                    text: qsTr("Your system has pending updates that must be installed before you can install new kernels.\n\nPlease run system upgrade first using your package manager.")
+                }
             }
         }
     }
-    
+
     Connections {
         target: vm
         
         function onTransactionError(errorTitle, errorMessage) {
+            const errorDialog = root.dialog(errorDialogLoader)
             errorDialog.title = errorTitle
             errorDialog.subtitle = errorMessage
             errorDialog.open()
         }
         
         function onUpdatesPendingError() {
-            updatesPendingDialog.open()
+            root.dialog(updatesPendingDialogLoader).open()
         }
     }
 
-    Components.ConfirmationDialog {
-        id: confirmationDialog
-
-        // State
-        property bool uninstallation: false
-        property var kernelData: null
-
-        /**
-         * Opens confirmation dialog
-         * @param {var} kernelData - KernelData object from C++
-         * @param {bool} uninstallation - True for removal, false for installation
-         */
-        function open(kernelData: var, uninstallation: bool) {
-            confirmationDialog.kernelData = kernelData
-            confirmationDialog.uninstallation = uninstallation
-            confirmationDialog.visible = true
-        }
+    Loader {
+        id: confirmationDialogLoader
 
-        onAccepted: {
-            if (!confirmationDialog.uninstallation) {
-                vm.installKernel(confirmationDialog.kernelData)
-            } else {
-                vm.removeKernel(confirmationDialog.kernelData)
-            }
-        }
+        active: false
 
-        ColumnLayout {
-            spacing: Kirigami.Units.largeSpacing
+        sourceComponent: Components.ConfirmationDialog {
+            id: confirmationDialog
 
-            QQC2.Label {
-                Layout.fillWidth: true
+            // State
+            property bool uninstallation: false
+            property var kernelData: null
 
-                textFormat: Text.MarkdownText
-                wrapMode: Text.WordWrap
-                text: !confirmationDialog.uninstallation 
-                    ? qsTr("New kernel **%1** is ready to install.").arg(confirmationDialog.kernelData?.name ?? "")
-                    : qsTr("Do you want to remove **%1**?").arg(confirmationDialog.kernelData?.name ?? "")
+            /**
+             * Opens confirmation dialog
+             * @param {var} kernelData - KernelData object from C++
+             * @param {bool} uninstallation - True for removal, false for installation
+             */
+            function open(kernelData: var, uninstallation: bool) {
+                confirmationDialog.kernelData = kernelData
+                confirmationDialog.uninstallation = uninstallation
+                confirmationDialog.visible = true
             }
-            
-            Kirigami.ShadowedRectangle {
-                Layout.fillWidth: true
-                Layout.preferredHeight: extraPackagesColumn.implicitHeight + Kirigami.Units.largeSpacing * 2
 
-                visible: (extraPackagesList.count > 0) && !confirmationDialog.uninstallation
+            onAccepted: {
+                if (!confirmationDialog.uninstallation) {
+                    vm.installKernel(confirmationDialog.kernelData)
+                } else {
+                    vm.removeKernel(confirmationDialog.kernelData)
+                }
+            }
 
-                color: Kirigami.Theme.backgroundColor
-                radius: Kirigami.Units.mediumSpacing
-                
-                shadow.size: Kirigami.Units.smallSpacing
-                shadow.color: Qt.rgba(0, 0, 0, 0.1)
+            ColumnLayout {
+                spacing: Kirigami.Units.largeSpacing
 
-                ColumnLayout {
-                    id: extraPackagesColumn
+                QQC2.Label {
+                    Layout.fillWidth: true
 
-                    anchors.fill: parent
-                    anchors.margins: Kirigami.Units.largeSpacing
+                    textFormat: Text.MarkdownText
+                    wrapMode: Text.WordWrap
+                    text: !confirmationDialog.uninstallation 
+                        ? qsTr("New kernel **%1** is ready to install.").arg(confirmationDialog.kernelData?.name ?? "")
+                        : qsTr("Do you want to remove **%1**?").arg(confirmationDialog.kernelData?.name ?? "")
+                }
 
-                    spacing: Kirigami.Units.mediumSpacing
+                Kirigami.ShadowedRectangle {
+                    Layout.fillWidth: true
+                    Layout.preferredHeight: extraPackagesColumn.implicitHeight + Kirigami.Units.largeSpacing * 2
 
-                    QQC2.Label {
-                        Layout.fillWidth: true
+                    visible: (extraPackagesList.count > 0) && !confirmationDialog.uninstallation
 
-                        font.weight: Font.DemiBold
-                        text: qsTr("Following extra packages will be installed:")
-                    }
+                    color: Kirigami.Theme.backgroundColor
+                    radius: Kirigami.Units.mediumSpacing
 
-                    ListView {
-                        id: extraPackagesList
+                    shadow.size: Kirigami.Units.smallSpacing
+                    shadow.color: Qt.rgba(0, 0, 0, 0.1)
 
-                        Layout.fillWidth: true
-                        Layout.preferredHeight: contentHeight
+                    ColumnLayout {
+                        id: extraPackagesColumn
 
-                        model: confirmationDialog.kernelData?.extraModules ?? []
-                        interactive: false
-                        spacing: Kirigami.Units.smallSpacing
+                        anchors.fill: parent
+                        anchors.margins: Kirigami.Units.largeSpacing
 
-                        delegate: RowLayout {
-                            width: ListView.view.width
-                            spacing: Kirigami.Units.mediumSpacing
+                        spacing: Kirigami.Units.mediumSpacing
 
-                            Kirigami.Icon {
-                                Layout.preferredWidth: Kirigami.Units.iconSizes.small
-                                Layout.preferredHeight: Kirigami.Units.iconSizes.small
+                        QQC2.Label {
+                            Layout.fillWidth: true
 
-                                source: "package-installed-updated"
-                                color: Kirigami.Theme.textColor
-                            }
+                            font.weight: Font.DemiBold
+                            text: qsTr("Following extra packages will be installed:")
+                        }
 
-                            QQC2.Label {
-                                Layout.fillWidth: true
+                        ListView {
+                            id: extraPackagesList
 
-                                text: modelData
-                                elide: Text.ElideRight
+                            Layout.fillWidth: true
+                            Layout.preferredHeight: contentHeight
+
+                            model: confirmationDialog.kernelData?.extraModules ?? []
+                            interactive: false
+                            spacing: Kirigami.Units.smallSpacing
+
+                            delegate: RowLayout {
+                                width: ListView.view.width
+                                spacing: Kirigami.Units.mediumSpacing
+
+                                Kirigami.Icon {
+                                    Layout.preferredWidth: Kirigami.Units.iconSizes.small
+                                    Layout.preferredHeight: Kirigami.Units.iconSizes.small
+
+                                    source: "package-installed-updated"
+                                    color: Kirigami.Theme.textColor
+                                }
+
+                                QQC2.Label {
+                                    Layout.fillWidth: true
+
+                                    text: modelData
+                                    elide: Text.ElideRight
+                                }
                             }
                         }
                     }
@@ -173,14 +206,14 @@ QQC2.Page {
         
         spacing: Kirigami.Units.smallSpacing
 
-        // Loading overlay
+        // Loading overlay, only until the first catalog arrives; refreshes update in place
         Rectangle {
             id: loadingOverlay
             
             Layout.fillWidth: true
             Layout.fillHeight: true
             
-            visible: loadingProgress.visible
+            visible: vm.loading && kernelListView.count === 0
             color: Kirigami.Theme.backgroundColor
             z: 999
             
@@ -200,7 +233,7 @@ QQC2.Page {
                     Layout.fillWidth: true
                     Layout.alignment: Qt.AlignHCenter
                     
-                    visible: false
+                    visible: text !== ""
                     horizontalAlignment: Text.AlignHCenter
                     wrapMode: Text.WordWrap
                     
@@ -208,15 +241,8 @@ QQC2.Page {
                         target: vm
                         
                         function onFetchProgress(current, total, kernelName) {
-                            if (total === 0) {
-                                loadingProgress.visible = false
-                                return
-                            }
-                            
-                            loadingProgress.visible = true
-                            
-                            if (current >= total) {
-                                loadingProgress.visible = false
+                            if (total === 0 || current >= total) {
+                                loadingProgress.text = ""
                             } else {
                                 loadingProgress.text = qsTr("Loading kernel metadata: %1 / %2\n%3").arg(current).arg(total).arg(kernelName)
                             }
@@ -226,22 +252,27 @@ QQC2.Page {
             }
         }
 
-        SelectedKernels {
+        // Created asynchronously, off the path to the first frame
+        Loader {
             Layout.fillWidth: true
             Layout.preferredHeight: 100
             Layout.margins: Kirigami.Units.largeSpacing
-            
-            inUseKernel: vm.inUseKernelData
-            recommendedKernel: vm.recommendedKernelData
-            actionsEnabled: !confirmationDialog.visible && !errorDialog.visible
 
-            onShowChangelog: (changelogUrl) => {
-                Qt.openUrlExternally(changelogUrl)
-            }
+            asynchronous: true
 
-            onInstall: (kernelData) => confirmationDialog.open(kernelData, false)
+            sourceComponent: SelectedKernels {
+                inUseKernel: vm.inUseKernelData
+                recommendedKernel: vm.recommendedKernelData
+                actionsEnabled: !root.dialogOpen
 
-            onRemove: (kernelData) => confirmationDialog.open(kernelData, true)
+                onShowChangelog: (changelogUrl) => {
+                    Qt.openUrlExternally(changelogUrl)
+                }
+
+                onInstall: (kernelData) => root.dialog(confirmationDialogLoader).open(kernelData, false)
+
+                onRemove: (kernelData) => root.dialog(confirmationDialogLoader).open(kernelData, true)
+            }
         }
 
         Item {
@@ -256,15 +287,15 @@ QQC2.Page {
                 anchors.rightMargin: kernelScrollBar.width
                 
                 model: vm.model
-                actionsEnabled: !confirmationDialog.visible && !errorDialog.visible
+                actionsEnabled: !root.dialogOpen
 
                 onShowChangelog: (changelogUrl) => {
                     Qt.openUrlExternally(changelogUrl)
                 }
 
-                onInstall: (kernelData) => confirmationDialog.open(kernelData, false)
+                onInstall: (kernelData) => root.dialog(confirmationDialogLoader).open(kernelData, false)
                 
-                onRemove: (kernelData) => confirmationDialog.open(kernelData, true)
+                onRemove: (kernelData) => root.dialog(confirmationDialogLoader).open(kernelData, true)
                 
             }
 
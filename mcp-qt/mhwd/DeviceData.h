@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <QDataStream>
 #include <QMetaType>
 #include <QString>
 #include <QList>
@@ -54,6 +55,18 @@ public:
     bool operator==(const DeviceData& other) const = default;
 };
 
+inline QDataStream& operator<<(QDataStream& stream, const DeviceData& data)
+{
+    return stream << data.id << data.name << data.vendor << data.classId << data.vendorId << data.deviceId
+                  << data.busType << data.icon << data.hasDrivers << data.drivers << data.driver;
+}
+
+inline QDataStream& operator>>(QDataStream& stream, DeviceData& data)
+{
+    return stream >> data.id >> data.name >> data.vendor >> data.classId >> data.vendorId >> data.deviceId
+                  >> data.busType >> data.icon >> data.hasDrivers >> data.drivers >> data.driver;
+}
+
 } // namespace mcp::qt::mhwd
 
 Q_DECLARE_METATYPE(mcp::qt::mhwd::DeviceData)
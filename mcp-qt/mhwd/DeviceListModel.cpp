@@ -7,11 +7,7 @@
 
 #include "DeviceListModel.h"
 
-#include <QVariantMap>
-#include <ranges>
-
-#include <qcontainerfwd.h>
-#include <qhashfunctions.h>
+#include <algorithm>
 
 namespace mcp::qt::mhwd {
 
@@ -19,6 +15,8 @@ DeviceListModel::DeviceListModel(QObject* parent)
     : QAbstractListModel(parent) {
 }
 
+DeviceListModel::~DeviceListModel() = default;
+
 int DeviceListModel::rowCount(const QModelIndex& parent) const {
     if (parent.isValid()) {
         return 0;
@@ -39,40 +37,13 @@ QVariant DeviceListModel::data(const QModelIndex& index, int role) const {
     case Icon:
         return category.icon;
     case DeviceCount:
-        return static_cast<int>(category.devices.size());
-    case DriversAvailableCount: {
-        int count = 0;
-        for (const auto& device : category.devices) {
-            if (device.hasDrivers) {
-                count++;
-            }
-        }
-        return count;
-    }
-    case Devices: {
-        QVariantList deviceList;
-        for (const auto& device : category.devices) {
-            QVariantMap deviceMap;
-
-            auto drivers = device.drivers | std::views::transform([](auto driver) -> QVariant {
-                               return QVariant::fromValue(driver);
-                           });
-            deviceMap[QStringLiteral("id")] = device.id;
-            deviceMap[QStringLiteral("name")] = device.name;
-            deviceMap[QStringLiteral("vendor")] = device.vendor;
-            deviceMap[QStringLiteral("classId")] = device.classId;
-            deviceMap[QStringLiteral("vendorId")] = device.vendorId;
-            deviceMap[QStringLiteral("deviceId")] = device.deviceId;
-            deviceMap[QStringLiteral("busType")] = device.busType;
-            deviceMap[QStringLiteral("icon")] = device.icon;
-            deviceMap[QStringLiteral("hasDrivers")] = device.hasDrivers;
-            deviceMap[QStringLiteral("drivers")] = QVariantList(drivers.begin(), drivers.end());
-            deviceMap[QStringLiteral("driver")] = device.driver;
-
-            deviceList.append(deviceMap);
-        }
-        return deviceList;
-    }
+        return category.devices->count();
+    case DriversAvailableCount:
+        return category.devices->driversAvailableCount();
+    case Devices:
+        return QVariant::fromValue(category.devices.get());
+    case BusTypes:
+        return category.devices->busTypes();
     default:
         return {};
     }
@@ -83,14 +54,63 @@ QHash<int, QByteArray> DeviceListModel::roleNames() const {
             {Icon, "icon"},
             {DeviceCount, "deviceCount"},
             {DriversAvailableCount, "driversAvailableCount"},
-            {Devices, "devices"}};
+            {Devices, "devices"},
+            {BusTypes, "busTypes"}};
 }
 
 void DeviceListModel::setupCategories(const std::vector<CategoryData>& categories) {
-    beginResetModel();
-    m_categories = categories;
-    endResetModel();
-    Q_EMIT categoriesChanged();
+    const bool sameRows = std::ranges::equal(m_categories, categories, {}, &Category::name, &CategoryData::name);
+
+    if (!sameRows) {
+        beginResetModel();
+        m_categories.clear();
+        for (const auto& category : categories) {
+            m_categories.push_back(makeCategory(category));
+        }
+        endResetModel();
+        Q_EMIT categoriesChanged();
+        return;
+    }
+
+    // Same categories as before, only changed devices are touched
+    for (size_t row = 0; row < categories.size(); ++row) {
+        m_categories[row].devices->setDevices(categories[row].devices);
+    }
+}
+
+void DeviceListModel::upsertDevice(const QString& category, const DeviceData& device) {
+    auto target = std::ranges::find(m_categories, category, &Category::name);
+    if (target == m_categories.end()) {
+        return;
+    }
+
+    target->devices->upsertDevice(device);
+}
+
+void DeviceListModel::removeDevice(const QString& deviceId) {
+    for (auto& category : m_categories) {
+        category.devices->removeDevice(deviceId);
+    }
+}
+
+DeviceListModel::Category DeviceListModel::makeCategory(const CategoryData& data) {
+    Category category{data.name, data.icon, std::make_unique<DeviceModel>(this)};
+    category.devices->setDevices(data.devices);
+
+    // Counts and bus types are derived from the devices, refresh them with the row
+    connect(category.devices.get(), &DeviceModel::revisionChanged, this, [this, model = category.devices.get()] {
+        auto it = std::ranges::find_if(m_categories, [model](const Category& c) { return c.devices.get() == model; });
+        if (it != m_categories.end()) {
+            notifyCategoryChanged(static_cast<size_t>(it - m_categories.begin()));
+        }
+    });
+
+    return category;
+}
+
+void DeviceListModel::notifyCategoryChanged(size_t row) {
+    const auto idx = index(static_cast<int>(row));
+    Q_EMIT dataChanged(idx, idx, {DeviceCount, DriversAvailableCount, BusTypes});
 }
 
 } // namespace mcp::qt::mhwd
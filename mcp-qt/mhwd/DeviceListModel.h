@@ -6,17 +6,21 @@
  */
 
 /*
- * DeviceListModel - 2D array model for categories and devices.
- * Structure: Category rows with device arrays. All-or-nothing setup via setupCategories.
+ * DeviceListModel - category rows, each owning a DeviceModel of its devices.
+ * setupCategories only resets the model when the category rows differ,
+ * otherwise device changes go to the affected DeviceModel rows.
+ * Hotplug deltas via upsertDevice/removeDevice do the same.
  */
 
 #pragma once
 
 #include "DeviceData.h"
+#include "DeviceModel.h"
 
 #include <QAbstractListModel>
 #include <QString>
-#include <QVariantList>
+
+#include <memory>
 #include <vector>
 
 namespace mcp::qt::mhwd {
@@ -38,11 +42,13 @@ public:
         Icon,
         DeviceCount,
         DriversAvailableCount,
-        Devices // QVariantList of device objects
+        Devices,    // DeviceModel* of the category
+        BusTypes    // Bus types present in the category, for filtering
     };
     Q_ENUM(Role)
 
     explicit DeviceListModel(QObject* parent = nullptr);
+    ~DeviceListModel() override;
 
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
@@ -50,11 +56,23 @@ public:
 
     void setupCategories(const std::vector<CategoryData>& categories);
 
+    void upsertDevice(const QString& category, const DeviceData& device);
+    void removeDevice(const QString& deviceId);
+
 Q_SIGNALS:
     void categoriesChanged();
 
 private:
-    std::vector<CategoryData> m_categories;
+    struct Category {
+        QString name;
+        QString icon;
+        std::unique_ptr<DeviceModel> devices;
+    };
+
+    Category makeCategory(const CategoryData& data);
+    void notifyCategoryChanged(size_t row);
+
+    std::vector<Category> m_categories;
 };
 
 } // namespace mcp::qt::mhwd
@@ -0,0 +1,223 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "DeviceModel.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace mcp::qt::mhwd {
+
+DeviceModel::DeviceModel(QObject* parent)
+    : QAbstractListModel(parent) {
+}
+
+int DeviceModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return count();
+}
+
+QVariant DeviceModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= count()) {
+        return {};
+    }
+
+    const auto& row = m_rows[static_cast<size_t>(index.row())];
+    const auto& device = row.device;
+
+    switch (role) {
+    case Id:
+        return device.id;
+    case Name:
+        return device.name;
+    case Vendor:
+        return device.vendor;
+    case ClassId:
+        return device.classId;
+    case VendorId:
+        return device.vendorId;
+    case DeviceId:
+        return device.deviceId;
+    case BusType:
+        return device.busType;
+    case Icon:
+        return device.icon;
+    case HasDrivers:
+        return device.hasDrivers;
+    case Drivers:
+        return row.drivers;
+    case Driver:
+        return device.driver;
+    case Data:
+        return row.map;
+    default:
+        return {};
+    }
+}
+
+QHash<int, QByteArray> DeviceModel::roleNames() const {
+    return {{Id, "id"},
+            {Name, "name"},
+            {Vendor, "vendor"},
+            {ClassId, "classId"},
+            {VendorId, "vendorId"},
+            {DeviceId, "deviceId"},
+            {BusType, "busType"},
+            {Icon, "icon"},
+            {HasDrivers, "hasDrivers"},
+            {Drivers, "drivers"},
+            {Driver, "driver"},
+            {Data, "deviceData"}};
+}
+
+int DeviceModel::driversAvailableCount() const {
+    return static_cast<int>(std::ranges::count_if(m_rows, [](const Row& row) { return row.device.hasDrivers; }));
+}
+
+QVariantMap DeviceModel::get(const QString& id) const {
+    auto it = findRow(id);
+    return it != m_rows.end() ? it->map : QVariantMap{};
+}
+
+const DeviceData* DeviceModel::find(const QString& id) const {
+    auto it = findRow(id);
+    return it != m_rows.end() ? &it->device : nullptr;
+}
+
+QStringList DeviceModel::busTypes() const {
+    QStringList result;
+    for (const auto& row : m_rows) {
+        if (!result.contains(row.device.busType)) {
+            result.append(row.device.busType);
+        }
+    }
+    return result;
+}
+
+void DeviceModel::setDevices(const std::vector<DeviceData>& devices) {
+    const int oldCount = count();
+    const int oldAvailable = driversAvailableCount();
+    bool changed = false;
+
+    // Backwards so earlier row numbers stay valid while removing
+    for (size_t row = m_rows.size(); row-- > 0;) {
+        const auto& id = m_rows[row].device.id;
+        if (std::ranges::none_of(devices, [&](const DeviceData& device) { return device.id == id; })) {
+            removeRow(row);
+            changed = true;
+        }
+    }
+
+    for (const auto& device : devices) {
+        auto it = findRow(device.id);
+        if (it == m_rows.end()) {
+            appendRow(device);
+            changed = true;
+        } else if (it->device != device) {
+            updateRow(static_cast<size_t>(it - m_rows.begin()), device);
+            changed = true;
+        }
+    }
+
+    if (oldCount != count() || oldAvailable != driversAvailableCount()) {
+        Q_EMIT countChanged();
+    }
+    if (changed) {
+        bumpRevision();
+    }
+}
+
+void DeviceModel::upsertDevice(const DeviceData& device) {
+    auto it = findRow(device.id);
+    const int oldAvailable = driversAvailableCount();
+
+    if (it == m_rows.end()) {
+        appendRow(device);
+        Q_EMIT countChanged();
+    } else if (it->device == device) {
+        return;
+    } else {
+        updateRow(static_cast<size_t>(it - m_rows.begin()), device);
+        if (oldAvailable != driversAvailableCount()) {
+            Q_EMIT countChanged();
+        }
+    }
+
+    bumpRevision();
+}
+
+bool DeviceModel::removeDevice(const QString& id) {
+    auto it = findRow(id);
+    if (it == m_rows.end()) {
+        return false;
+    }
+
+    removeRow(static_cast<size_t>(it - m_rows.begin()));
+    Q_EMIT countChanged();
+    bumpRevision();
+    return true;
+}
+
+std::vector<DeviceModel::Row>::iterator DeviceModel::findRow(const QString& id) {
+    return std::ranges::find_if(m_rows, [&](const Row& row) { return row.device.id == id; });
+}
+
+std::vector<DeviceModel::Row>::const_iterator DeviceModel::findRow(const QString& id) const {
+    return std::ranges::find_if(m_rows, [&](const Row& row) { return row.device.id == id; });
+}
+
+DeviceModel::Row DeviceModel::makeRow(const DeviceData& device) {
+    Row row{device, {}, {}};
+
+    for (const auto& driver : device.drivers) {
+        row.drivers.append(QVariant::fromValue(driver));
+    }
+
+    row.map[QStringLiteral("id")] = device.id;
+    row.map[QStringLiteral("name")] = device.name;
+    row.map[QStringLiteral("vendor")] = device.vendor;
+    row.map[QStringLiteral("classId")] = device.classId;
+    row.map[QStringLiteral("vendorId")] = device.vendorId;
+    row.map[QStringLiteral("deviceId")] = device.deviceId;
+    row.map[QStringLiteral("busType")] = device.busType;
+    row.map[QStringLiteral("icon")] = device.icon;
+    row.map[QStringLiteral("hasDrivers")] = device.hasDrivers;
+    row.map[QStringLiteral("drivers")] = row.drivers;
+    row.map[QStringLiteral("driver")] = device.driver;
+
+    return row;
+}
+
+void DeviceModel::updateRow(size_t row, const DeviceData& device) {
+    m_rows[row] = makeRow(device);
+
+    const auto idx = index(static_cast<int>(row));
+    Q_EMIT dataChanged(idx, idx);
+}
+
+void DeviceModel::appendRow(const DeviceData& device) {
+    const int row = count();
+    beginInsertRows({}, row, row);
+    m_rows.push_back(makeRow(device));
+    endInsertRows();
+}
+
+void DeviceModel::removeRow(size_t row) {
+    const int r = static_cast<int>(row);
+    beginRemoveRows({}, r, r);
+    m_rows.erase(m_rows.begin() + static_cast<std::ptrdiff_t>(row));
+    endRemoveRows();
+}
+
+void DeviceModel::bumpRevision() {
+    ++m_revision;
+    Q_EMIT revisionChanged();
+}
+
+} // namespace mcp::qt::mhwd
@@ -0,0 +1,107 @@
+/* === This file is part of MCP ===
+ *
+ *   SPDX-FileCopyrightText: 2025 Artem Grinev <agrinev@manjaro.org>
+ *   SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/*
+ * DeviceModel - devices of one category, one row per device.
+ * QML-facing values are converted once per device change and cached,
+ * so binding re-evaluation never re-marshals the whole category.
+ */
+
+#pragma once
+
+#include "DeviceData.h"
+
+#include <QAbstractListModel>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+
+#include <vector>
+
+namespace mcp::qt::mhwd {
+
+class DeviceModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int driversAvailableCount READ driversAvailableCount NOTIFY countChanged)
+    Q_PROPERTY(int revision READ revision NOTIFY revisionChanged)
+
+public:
+    enum Role {
+        Id = Qt::UserRole + 1,
+        Name,
+        Vendor,
+        ClassId,
+        VendorId,
+        DeviceId,
+        BusType,
+        Icon,
+        HasDrivers,
+        Drivers,    // QVariantList of DriverData
+        Driver,
+        Data        // Whole device as QVariantMap
+    };
+    Q_ENUM(Role)
+
+    explicit DeviceModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return static_cast<int>(m_rows.size()); }
+    int driversAvailableCount() const;
+
+    // Bumped on every change, lets bindings over get() re-evaluate
+    int revision() const { return m_revision; }
+
+    /**
+     * Device as QVariantMap, empty if there is no such device.
+     */
+    Q_INVOKABLE QVariantMap get(const QString& id) const;
+
+    const DeviceData* find(const QString& id) const;
+    QStringList busTypes() const;
+
+    /**
+     * Replace the contents, keyed by device id: rows of vanished devices
+     * are removed, changed ones updated in place and new ones appended.
+     */
+    void setDevices(const std::vector<DeviceData>& devices);
+
+    void upsertDevice(const DeviceData& device);
+    bool removeDevice(const QString& id);
+
+Q_SIGNALS:
+    void countChanged();
+    void revisionChanged();
+
+private:
+    struct Row {
+        DeviceData device;
+        QVariantList drivers;
+        QVariantMap map;
+    };
+
+    static Row makeRow(const DeviceData& device);
+
+    std::vector<Row>::iterator findRow(const QString& id);
+    std::vector<Row>::const_iterator findRow(const QString& id) const;
+
+    void updateRow(size_t row, const DeviceData& device);
+    void appendRow(const DeviceData& device);
+    void removeRow(size_t row);
+    void bumpRevision();
+
+    std::vector<Row> m_rows;
+    int m_revision = 0;
+};
+
+} // namespace mcp::qt::mhwd
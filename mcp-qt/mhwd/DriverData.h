@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <QDataStream>
 #include <QMetaType>
 #include <QString>
 
@@ -46,6 +47,19 @@ public:
     bool operator==(const DriverData& other) const = default;
 };
 
+// Used by the on-disk category cache, see MhwdViewModel
+inline QDataStream& operator<<(QDataStream& stream, const DriverData& data)
+{
+    return stream << data.id << data.name << data.version << data.info
+                  << data.openSource << data.installed << data.recommended << data.priority;
+}
+
+inline QDataStream& operator>>(QDataStream& stream, DriverData& data)
+{
+    return stream >> data.id >> data.name >> data.version >> data.info
+                  >> data.openSource >> data.installed >> data.recommended >> data.priority;
+}
+
 } // namespace mcp::qt::mhwd
 
 Q_DECLARE_METATYPE(mcp::qt::mhwd::DriverData)
@@ -11,50 +11,320 @@
 #include "DeviceProvider.hpp"
 #include "Transaction.hpp"
 #include <TransactionAgentLauncher.h>
+#include <DiskCache.hpp>
+#include <StartupTrace.hpp>
 
 #include <QCoroQmlTask>
 #include <QCoroTask>
+#include <QCoroThread>
+
+#include <QDataStream>
+
+#include <coro/when_all.hpp>
+
+#include <array>
+#include <mutex>
+#include <optional>
+#include <ranges>
 
 #include <qcontainerfwd.h>
 
 namespace mcp::qt::mhwd {
 
+namespace {
+
+// Category rows in display order, indexed by categoryIndex()
+const std::array<std::pair<QString, QString>, 6> c_categoryIcons = {{
+    {QStringLiteral("Display"), QStringLiteral("video-display")},
+    {QStringLiteral("Network"), QStringLiteral("network-wired")},
+    {QStringLiteral("Audio"), QStringLiteral("audio-card")},
+    {QStringLiteral("Storage"), QStringLiteral("drive-harddisk")},
+    {QStringLiteral("Input"), QStringLiteral("input-mouse")},
+    {QStringLiteral("Misc"), QStringLiteral("computer")}
+}};
+
+size_t categoryIndex(mcp::mhwd::DeviceCategory category)
+{
+    using mcp::mhwd::DeviceCategory;
+
+    switch (category) {
+        case DeviceCategory::Graphics: return 0;
+        case DeviceCategory::Network: return 1;
+        case DeviceCategory::Audio: return 2;
+        case DeviceCategory::Storage: return 3;
+        case DeviceCategory::Input: return 4;
+        case DeviceCategory::Unknown: return 5;
+    }
+    return 5;
+}
+
+constexpr std::string_view c_cacheName = "mhwd-categories";
+constexpr quint32 c_cacheVersion = 1;
+
+QByteArray serializeCategories(const std::vector<CategoryData>& categories)
+{
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << c_cacheVersion << static_cast<quint32>(categories.size());
+    for (const auto& category : categories) {
+        stream << category.name << category.icon << static_cast<quint32>(category.devices.size());
+        for (const auto& device : category.devices) {
+            stream << device;
+        }
+    }
+
+    return bytes;
+}
+
+std::optional<std::vector<CategoryData>> parseCategories(const QByteArray& bytes)
+{
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 version = 0;
+    quint32 count = 0;
+    stream >> version >> count;
+    if (version != c_cacheVersion || count != c_categoryIcons.size()) {
+        return std::nullopt;
+    }
+
+    std::vector<CategoryData> categories(count);
+    for (auto& category : categories) {
+        quint32 devices = 0;
+        stream >> category.name >> category.icon >> devices;
+        if (stream.status() != QDataStream::Ok || devices > static_cast<quint32>(bytes.size())) {
+            return std::nullopt;
+        }
+
+        category.devices.resize(devices);
+        for (auto& device : category.devices) {
+            stream >> device;
+        }
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        return std::nullopt;
+    }
+    return categories;
+}
+
+// Spawned on the scheduler with its own copy, keeps encoding and writing off the GUI thread
+mcp::Task<void> storeCategories(std::string stamp, std::vector<CategoryData> categories)
+{
+    mcp::cache::store(c_cacheName, stamp, serializeCategories(categories).toStdString());
+    co_return;
+}
+
+} // namespace
+
 MhwdViewModel::MhwdViewModel(QObject* parent)
     : QObject(parent)
     , m_categoryModel(std::make_unique<DeviceListModel>(this))
+    , m_configProvider(std::make_unique<mcp::mhwd::ConfigProvider>(m_deviceProvider))
 {
     QCoro::connect(init(), this, [](){});
 }
 
+MhwdViewModel::~MhwdViewModel()
+{
+    // No hotplug callbacks may run against a half-destroyed view model
+    m_deviceProvider.stop_monitoring();
+}
+
 QCoro::Task<void> MhwdViewModel::init()
 {
+    // Scanning resumes on a scheduler thread, where this may be going away
+    QPointer<MhwdViewModel> self(this);
+    auto* guiThread = thread();
+
     co_await m_deviceProvider.scan();
-    m_configProvider = std::make_unique<mcp::mhwd::ConfigProvider>(m_deviceProvider);
-    co_await populateCategories();
+    co_await QCoro::moveToThread(guiThread);
+
+    if (!self) {
+        co_return;
+    }
+
+    // Hotplug deltas arrive on a scheduler thread, hop to ours before touching the model
+    m_deviceProvider.signal_devices_changed.connect([this](const mcp::mhwd::DeviceChangeVector& changes) {
+        // Explicit refreshes repopulate everything anyway
+        if (m_explicitScans > 0) {
+            return;
+        }
+        QMetaObject::invokeMethod(
+            this,
+            [this, changes]() { QCoro::connect(applyDeviceChanges(changes), this, [](){}); },
+            ::Qt::QueuedConnection);
+    });
+    m_monitoring = m_deviceProvider.start_monitoring();
+
+    // Any frontend that ran before, KCM or standalone, may have left the result warm
+    if (!co_await restoreCategories()) {
+        co_await populateCategories();
+    }
+}
+
+mcp::Task<std::string> MhwdViewModel::cacheStamp() const
+{
+    co_await mcp::io_scheduler().schedule();
+
+    // Device names come from hwdata, which is updated through pacman
+    co_return mcp::cache::pacman_stamp() + m_configProvider->cache_stamp();
+}
+
+QCoro::Task<bool> MhwdViewModel::restoreCategories()
+{
+    mcp::trace::Scope scope("MhwdViewModel::restoreCategories");
+
+    // Stamping, reading and decoding all stay on the scheduler thread
+    const auto stamp = co_await cacheStamp();
+    const auto cached = mcp::cache::load(c_cacheName, stamp);
+    auto categories = cached ? parseCategories(QByteArray::fromStdString(*cached)) : std::nullopt;
+    co_await QCoro::moveToThread(thread());
+
+    if (!categories) {
+        co_return false;
+    }
+
+    std::array<RecommendedNames, mcp::mhwd::c_bus_types.size()> recommended;
+    for (const auto& category : *categories) {
+        for (const auto& device : category.devices) {
+            const auto bus = mcp::mhwd::bus_type_from_string(device.busType.toStdString());
+            if (!bus) {
+                continue;
+            }
+            for (const auto& driver : device.drivers) {
+                if (driver.recommended) {
+                    recommended[static_cast<size_t>(*bus)].insert(driver.id.toStdString());
+                }
+            }
+        }
+    }
+
+    m_recommended = std::move(recommended);
+    m_categoryModel->setupCategories(*categories);
+
+    co_return true;
 }
 
 QCoro::QmlTask MhwdViewModel::refreshDevices()
 {
-    return populateCategories();
+    return [](MhwdViewModel* self) -> QCoro::Task<void> {
+        // With the monitor running the device cache is already current.
+        // Otherwise rescan, its deltas are covered by the populate below.
+        if (!self->m_monitoring) {
+            QPointer<MhwdViewModel> guard(self);
+            auto* guiThread = self->thread();
+
+            ++self->m_explicitScans;
+            co_await self->m_deviceProvider.scan();
+            co_await QCoro::moveToThread(guiThread);
+
+            if (!guard) {
+                co_return;
+            }
+            --self->m_explicitScans;
+        }
+        self->m_configProvider->reload();
+        co_await self->populateCategories();
+    }(this);
 }
 
-QCoro::Task<QList<DriverData>> MhwdViewModel::findDrivers(const ::mcp::mhwd::Device& device)
+QCoro::Task<void> MhwdViewModel::applyDeviceChanges(mcp::mhwd::DeviceChangeVector changes)
 {
-    QList<DriverData> result;
-    
-    const auto configs = co_await m_configProvider->find_matching_configs_for_device(device);
-    
-    auto installedConfigs = co_await m_configProvider->get_installed_configs(device.bus_type());
-    std::vector<std::string> installedNames;
-    if (installedConfigs) {
-        for (const auto& cfg : *installedConfigs) {
-            installedNames.push_back(cfg.name());
+    using Kind = mcp::mhwd::DeviceChange::Kind;
+
+    // A new or changed device may have a best driver nothing was recommended for yet
+    std::array<bool, mcp::mhwd::c_bus_types.size()> affected{};
+    for (const auto& change : changes) {
+        if (change.kind != Kind::Removed) {
+            affected[static_cast<size_t>(change.device.bus_type())] = true;
         }
     }
-    
+    for (auto bus : mcp::mhwd::c_bus_types) {
+        if (affected[static_cast<size_t>(bus)]) {
+            m_recommended[static_cast<size_t>(bus)] = co_await recommendedNames(bus);
+        }
+    }
+
+    for (const auto& change : changes) {
+        if (change.kind == Kind::Removed) {
+            m_categoryModel->removeDevice(QString::fromStdString(mcp::mhwd::to_string(change.device.key())));
+            continue;
+        }
+
+        DeviceData data = co_await createDeviceData(change.device);
+        m_categoryModel->upsertDevice(determineCategoryForDevice(change.device), data);
+    }
+}
+
+QCoro::Task<MhwdViewModel::InstalledNames> MhwdViewModel::installedNames(mcp::mhwd::BusType bus)
+{
+    // Unchanged /var/lib/mhwd/local, nothing to re-read
+    const auto generation = m_configProvider->installed_generation(bus);
+    auto& cached = m_installedCache[static_cast<size_t>(bus)];
+    if (cached && cached->generation == generation) {
+        co_return cached->names;
+    }
+
+    InstalledNames names;
+
+    auto installed = co_await m_configProvider->get_installed_configs(bus);
+    if (installed) {
+        for (const auto& config : *installed) {
+            names.insert(config.name());
+        }
+    }
+
+    cached = InstalledCacheEntry{generation, names};
+    co_return names;
+}
+
+QCoro::Task<MhwdViewModel::RecommendedNames> MhwdViewModel::recommendedNames(mcp::mhwd::BusType bus)
+{
+    RecommendedNames names;
+
+    auto selection = co_await m_configProvider->select_best(bus, mcp::mhwd::DriverSelection::NonFree);
+    if (selection) {
+        for (const auto& config : selection->best) {
+            names.insert(config.name());
+        }
+    }
+
+    co_return names;
+}
+
+mcp::Task<mcp::mhwd::ConfigVector> MhwdViewModel::matchDevice(const mcp::mhwd::Device& device) const
+{
+    const auto generation = m_configProvider->available_generation(device.bus_type());
+    auto key = device.key();
+
+    {
+        std::lock_guard lock(m_matchCacheMutex);
+        auto it = m_matchCache.find(key);
+        if (it != m_matchCache.end() && it->second.generation == generation
+            && it->second.classId == device.class_id()) {
+            co_return it->second.configs;
+        }
+    }
+
+    auto configs = co_await m_configProvider->find_matching_configs_for_device(device);
+
+    std::lock_guard lock(m_matchCacheMutex);
+    m_matchCache.insert_or_assign(std::move(key), MatchCacheEntry{generation, device.class_id(), configs});
+    co_return configs;
+}
+
+QList<DriverData> MhwdViewModel::createDriverList(const mcp::mhwd::ConfigVector& configs,
+                                                  const InstalledNames& installed,
+                                                  const RecommendedNames& recommended) const
+{
+    QList<DriverData> result;
+    result.reserve(static_cast<qsizetype>(configs.size()));
+
     for (const auto& config : configs) {
-        bool installed = std::ranges::contains(installedNames, config.name());
-        result.append(createDriverData(config, installed));
+        result.append(createDriverData(config, installed.contains(config.name()), recommended.contains(config.name())));
     }
     
     // Higher priority first
@@ -62,7 +332,7 @@ QCoro::Task<QList<DriverData>> MhwdViewModel::findDrivers(const ::mcp::mhwd::Dev
         return a.priority > b.priority;
     });
     
-    co_return result;
+    return result;
 }
 
 QCoro::QmlTask MhwdViewModel::installDriver(const QString& driverId)
@@ -97,64 +367,122 @@ QCoro::QmlTask MhwdViewModel::removeDriver(const QString& driverId)
 
 QCoro::Task<void> MhwdViewModel::populateCategories()
 {
-    const std::vector<std::pair<QString, QString>> categoryIcons = {
-        {QStringLiteral("Display"), QStringLiteral("video-display")},
-        {QStringLiteral("Network"), QStringLiteral("network-wired")},
-        {QStringLiteral("Audio"), QStringLiteral("audio-card")},
-        {QStringLiteral("Storage"), QStringLiteral("drive-harddisk")},
-        {QStringLiteral("Input"), QStringLiteral("input-mouse")},
-        {QStringLiteral("Misc"), QStringLiteral("computer")}
-    };
-    
-    co_await m_deviceProvider.scan();
-    auto devices = m_deviceProvider.all_devices();
-    
-    std::vector<CategoryData> categories;
-    for (const auto& [name, icon] : categoryIcons) {
-        CategoryData catData;
-        catData.name = name;
-        catData.icon = icon;
-        
-        for (const auto& device : devices) {
-            QString category = determineCategoryForDevice(device);
-            if (category == name) {
-                DeviceData data = co_await createDeviceData(device);
-                catData.devices.push_back(data);
-            }
+    mcp::trace::Scope scope("MhwdViewModel::populateCategories");
+
+    // Taken before matching, a database change in between only causes a cache miss
+    const auto stamp = co_await cacheStamp();
+    co_await QCoro::moveToThread(thread());
+
+    const auto devices = m_deviceProvider.all_devices();
+
+    // Built locally, the bucket tasks read it off the GUI thread
+    std::array<RecommendedNames, mcp::mhwd::c_bus_types.size()> recommended;
+    std::array<InstalledNames, mcp::mhwd::c_bus_types.size()> installed;
+
+    for (auto bus : mcp::mhwd::c_bus_types) {
+        if (!m_deviceProvider.is_enabled(bus)) {
+            continue;
         }
-        
-        categories.push_back(std::move(catData));
+        recommended[static_cast<size_t>(bus)] = co_await recommendedNames(bus);
+        installed[static_cast<size_t>(bus)] = co_await installedNames(bus);
     }
-    
+
+    // One pass over the devices puts each into its category bucket
+    std::vector<CategoryData> categories;
+    categories.reserve(c_categoryIcons.size());
+    for (const auto& [name, icon] : c_categoryIcons) {
+        categories.push_back({name, icon, {}});
+    }
+
+    std::vector<std::vector<const mcp::mhwd::Device*>> buckets(categories.size());
+    for (const auto& device : devices) {
+        buckets[categoryIndex(device.category())].push_back(&device);
+    }
+
+    // Buckets are independent, build them side by side on the scheduler
+    std::vector<mcp::Task<std::vector<DeviceData>>> tasks;
+    tasks.reserve(buckets.size());
+    for (const auto& bucket : buckets) {
+        tasks.push_back(createBucketData(bucket, installed, recommended));
+    }
+
+    auto results = co_await coro::when_all(std::move(tasks));
+    co_await QCoro::moveToThread(thread());
+
+    for (size_t i = 0; i < categories.size(); ++i) {
+        categories[i].devices = std::move(results[i].return_value());
+    }
+
+    m_recommended = std::move(recommended);
+
     m_categoryModel->setupCategories(categories);
+    mcp::io_scheduler().spawn(storeCategories(stamp, std::move(categories)));
+
+    // Forget devices that are gone, a replugged one is simply matched again
+    {
+        const auto present = devices
+            | std::views::transform(&mcp::mhwd::Device::key)
+            | std::ranges::to<std::unordered_set<mcp::mhwd::DeviceKey>>();
+
+        std::lock_guard lock(m_matchCacheMutex);
+        std::erase_if(m_matchCache, [&](const auto& kv) { return !present.contains(kv.first); });
+    }
+}
+
+mcp::Task<std::vector<DeviceData>>
+MhwdViewModel::createBucketData(std::vector<const mcp::mhwd::Device*> devices,
+                                const std::array<InstalledNames, mcp::mhwd::c_bus_types.size()>& installed,
+                                const std::array<RecommendedNames, mcp::mhwd::c_bus_types.size()>& recommended) const
+{
+    co_await mcp::io_scheduler().schedule();
+
+    std::vector<DeviceData> result;
+    result.reserve(devices.size());
+
+    for (const auto* device : devices) {
+        auto configs = co_await matchDevice(*device);
+        const auto bus = static_cast<size_t>(device->bus_type());
+        result.push_back(createDeviceData(*device, configs, installed[bus], recommended[bus]));
+    }
+
+    co_return result;
 }
 
 QCoro::Task<DeviceData> MhwdViewModel::createDeviceData(const mcp::mhwd::Device& device)
+{
+    auto configs = co_await matchDevice(device);
+    auto installed = co_await installedNames(device.bus_type());
+
+    co_return createDeviceData(device, configs, installed, m_recommended[static_cast<size_t>(device.bus_type())]);
+}
+
+DeviceData MhwdViewModel::createDeviceData(const mcp::mhwd::Device& device,
+                                           const mcp::mhwd::ConfigVector& configs,
+                                           const InstalledNames& installed,
+                                           const RecommendedNames& recommended) const
 {
     DeviceData data;
     
-    data.id = QString::fromStdString(device.bus_id());
+    // Stable across rescans, so the model can match rows and keep the selection
+    data.id = QString::fromStdString(mcp::mhwd::to_string(device.key()));
     data.name = QString::fromStdString(device.device_name());
     data.vendor = QString::fromStdString(device.vendor_name());
-    data.classId = QString::fromStdString(device.class_id());
-    data.vendorId = QString::fromStdString(device.vendor_id());
-    data.deviceId = QString::fromStdString(device.device_id());
-    data.busType = device.bus_type() == mcp::mhwd::BusType::PCI ? QStringLiteral("PCI") : QStringLiteral("USB");
+    data.classId = QString::fromStdString(mcp::mhwd::to_hex_string(device.class_id()));
+    data.vendorId = QString::fromStdString(mcp::mhwd::to_hex_string(device.vendor_id()));
+    data.deviceId = QString::fromStdString(mcp::mhwd::to_hex_string(device.device_id()));
+    data.busType = QString::fromUtf8(mcp::mhwd::to_string(device.bus_type()));
     data.driver = QString::fromStdString(device.driver());
     
     QString category = determineCategoryForDevice(device);
     data.icon = determineIconForDevice(device, category);
 
-    auto drivers = co_await findDrivers(device);
-    data.drivers = drivers;
-
-    auto configs = co_await m_configProvider->find_matching_configs_for_device(device);
+    data.drivers = createDriverList(configs, installed, recommended);
     data.hasDrivers = !configs.empty();
     
-    co_return data;
+    return data;
 }
 
-DriverData MhwdViewModel::createDriverData(const mcp::mhwd::Config& config, bool installed) const
+DriverData MhwdViewModel::createDriverData(const mcp::mhwd::Config& config, bool installed, bool recommended) const
 {
     DriverData data;
     
@@ -164,7 +492,7 @@ DriverData MhwdViewModel::createDriverData(const mcp::mhwd::Config& config, bool
     data.info = QString::fromStdString(config.description());
     data.openSource = config.is_free_driver();
     data.installed = installed;
-    data.recommended = config.priority() >= 50;
+    data.recommended = recommended;
     data.priority = config.priority();
     
     return data;
@@ -172,17 +500,7 @@ DriverData MhwdViewModel::createDriverData(const mcp::mhwd::Config& config, bool
 
 QString MhwdViewModel::determineCategoryForDevice(const mcp::mhwd::Device& device) const
 {
-    using mcp::mhwd::DeviceCategory;
-    
-    switch (device.category()) {
-        case DeviceCategory::Graphics: return QStringLiteral("Display");
-        case DeviceCategory::Network: return QStringLiteral("Network");
-        case DeviceCategory::Audio: return QStringLiteral("Audio");
-        case DeviceCategory::Storage: return QStringLiteral("Storage");
-        case DeviceCategory::Input: return QStringLiteral("Input");
-        case DeviceCategory::Unknown: return QStringLiteral("Misc");
-    }
-    return QStringLiteral("Misc");
+    return c_categoryIcons[categoryIndex(device.category())].first;
 }
 
 QString MhwdViewModel::determineIconForDevice(const mcp::mhwd::Device& device, const QString& category) const
@@ -26,6 +26,15 @@
 #include <QObject>
 #include <QtQml>
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace mcp::qt::mhwd {
 
 class MhwdViewModel : public QObject
@@ -37,6 +46,7 @@ class MhwdViewModel : public QObject
 
 public:
     explicit MhwdViewModel(QObject* parent = nullptr);
+    ~MhwdViewModel() override;
 
     DeviceListModel* categoryModel() const { return m_categoryModel.get(); }
 
@@ -50,10 +60,36 @@ Q_SIGNALS:
 private:
     QCoro::Task<void> init();
     QCoro::Task<void> populateCategories();
-    QCoro::Task<QList<DriverData>> findDrivers(const mcp::mhwd::Device& device);
+    // Categories stored by the last populate of any frontend, if still valid
+    QCoro::Task<bool> restoreCategories();
+    mcp::Task<std::string> cacheStamp() const;
+    QCoro::Task<void> applyDeviceChanges(mcp::mhwd::DeviceChangeVector changes);
+    using InstalledNames = std::unordered_set<std::string>;
+    using RecommendedNames = std::unordered_set<std::string>;
+
+    // Installed names and per-device matches are cached, keyed by the
+    // ConfigProvider generations they were computed at
+    QCoro::Task<InstalledNames> installedNames(mcp::mhwd::BusType bus);
+    // Best config per device of the bus by auto-selection, installed or not
+    QCoro::Task<RecommendedNames> recommendedNames(mcp::mhwd::BusType bus);
+    mcp::Task<mcp::mhwd::ConfigVector> matchDevice(const mcp::mhwd::Device& device) const;
     QCoro::Task<DeviceData> createDeviceData(const mcp::mhwd::Device& device);
-    
-    DriverData createDriverData(const mcp::mhwd::Config& config, bool installed) const;
+
+    // Runs on an io_scheduler thread, touches no QObject and, apart from
+    // the match cache, only what it is handed
+    mcp::Task<std::vector<DeviceData>>
+    createBucketData(std::vector<const mcp::mhwd::Device*> devices,
+                     const std::array<InstalledNames, mcp::mhwd::c_bus_types.size()>& installed,
+                     const std::array<RecommendedNames, mcp::mhwd::c_bus_types.size()>& recommended) const;
+
+    DeviceData createDeviceData(const mcp::mhwd::Device& device,
+                                const mcp::mhwd::ConfigVector& configs,
+                                const InstalledNames& installed,
+                                const RecommendedNames& recommended) const;
+    QList<DriverData> createDriverList(const mcp::mhwd::ConfigVector& configs,
+                                       const InstalledNames& installed,
+                                       const RecommendedNames& recommended) const;
+    DriverData createDriverData(const mcp::mhwd::Config& config, bool installed, bool recommended) const;
     QString determineCategoryForDevice(const mcp::mhwd::Device& device) const;
     QString determineIconForDevice(const mcp::mhwd::Device& device, const QString& category) const;
 
@@ -61,6 +97,30 @@ private:
     mcp::mhwd::DeviceProvider m_deviceProvider;
     std::unique_ptr<mcp::mhwd::ConfigProvider> m_configProvider;
     mcp::qt::common::TransactionAgentLauncher m_transactionLauncher;
+    bool m_monitoring = false;
+    // Scans from refreshDevices(), whose change signals are not applied one by one
+    std::atomic<int> m_explicitScans = 0;
+
+    // Shown as recommended, per bus so hotplug can redo just the affected ones.
+    // GUI thread only, the workers are handed sets of their own
+    std::array<RecommendedNames, mcp::mhwd::c_bus_types.size()> m_recommended;
+
+    struct MatchCacheEntry {
+        std::uint64_t generation;
+        mcp::mhwd::HardwareId classId;
+        mcp::mhwd::ConfigVector configs;
+    };
+
+    struct InstalledCacheEntry {
+        std::uint64_t generation;
+        InstalledNames names;
+    };
+
+    // Filled from scheduler threads while categories are built
+    mutable std::mutex m_matchCacheMutex;
+    mutable std::unordered_map<mcp::mhwd::DeviceKey, MatchCacheEntry> m_matchCache;
+
+    std::array<std::optional<InstalledCacheEntry>, mcp::mhwd::c_bus_types.size()> m_installedCache;
 };
 
 } // namespace mcp::qt::mhwd
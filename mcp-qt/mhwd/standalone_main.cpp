@@ -12,27 +12,59 @@
 
 #include "MhwdViewModel.h"
 
+#include <QDir>
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQuickStyle>
+#include <QQuickWindow>
+
+#include <StartupTrace.hpp>
+
+#include <optional>
 
 using namespace mcp::qt::mhwd;
 
 int main(int argc, char* argv[])
 {
+    // Set MCP_TRACE_STARTUP=<file> to record the phases below
+    mcp::trace::instant("main");
+
+    std::optional<mcp::trace::Scope> phase;
+    phase.emplace("QGuiApplication");
+
     QGuiApplication app(argc, argv);
     app.setApplicationName(QStringLiteral("MCP Hardware Configuration"));
     app.setOrganizationName(QStringLiteral("Manjaro"));
 
     qmlRegisterType<MhwdViewModel>("org.manjaro.mcp.mhwd", 1, 0, "MhwdViewModel");
 
+    // The view model is created by QML, its own phases show up nested in here
+    phase.emplace("QML load");
+
     QQmlApplicationEngine engine;
-    engine.load(QUrl(QStringLiteral("qrc:/mhwd-standalone/ui/standalone_main.qml")));
+
+    // Installed modules, with QML_IMPORT_PATH re-added above them in its own
+    // order, so an uninstalled build runs with QML_IMPORT_PATH=<build>/bin
+    engine.addImportPath(QStringLiteral(MCP_QML_INSTALL_DIR));
+    const auto devPaths = qEnvironmentVariable("QML_IMPORT_PATH").split(QDir::listSeparator(), ::Qt::SkipEmptyParts);
+    for (auto it = devPaths.crbegin(); it != devPaths.crend(); ++it) {
+        engine.addImportPath(*it);
+    }
+
+    engine.loadFromModule("org.manjaro.mcp.mhwd", "standalone_main");
 
     if (engine.rootObjects().isEmpty()) {
         qCritical() << "Failed to load QML";
         return 1;
     }
 
+    phase.reset();
+
+    if (auto* window = qobject_cast<QQuickWindow*>(engine.rootObjects().constFirst())) {
+        QObject::connect(window, &QQuickWindow::frameSwapped, window, []() {
+            mcp::trace::ready("first frame");
+        }, ::Qt::SingleShotConnection);
+    }
+
     return app.exec();
 }
@@ -13,34 +13,46 @@ ColumnLayout {
     required property string categoryName
     required property string categoryIcon
     required property int categoryIndex
-    required property var categoryDevices // Array of device objects
+    required property var categoryDevices // DeviceModel of the category
+    required property int deviceCount
+    required property int driversAvailableCount
     required property string selectedDevice
     required property var installingDrivers
     required property var viewModel
 
     property bool isExpanded: true
 
+    // Device cards of collapsed categories are only created on first expansion
+    property bool devicesRequested: false
+
+    readonly property var selectedDeviceData: {
+        if (!root.categoryDevices || !root.selectedDevice) return null;
+
+        // revision re-runs the lookup whenever the devices change
+        root.categoryDevices.revision;
+        const device = root.categoryDevices.get(root.selectedDevice);
+        return device.id ? device : null;
+    }
+
     signal deviceSelected(deviceId: string)
     signal installDriver(deviceId: string, driverId: string)
     signal removeDriver(deviceId: string, driverId: string)
 
-    
 
-    readonly property int deviceCount: categoryDevices?.length ?? 0
+    Layout.fillWidth: true
+    spacing: Kirigami.Units.smallSpacing
 
-    readonly property int driversAvailableCount: {
-        if (!categoryDevices) return 0;
-        let count = 0;
-        for (let i = 0; i < categoryDevices.length; i++) {
-            if (categoryDevices[i].hasDrivers) {
-                count++;
-            }
+    onIsExpandedChanged: {
+        if (isExpanded) {
+            devicesRequested = true;
         }
-        return count;
     }
 
-    Layout.fillWidth: true
-    spacing: Kirigami.Units.smallSpacing
+    Component.onCompleted: {
+        if (isExpanded) {
+            devicesRequested = true;
+        }
+    }
 
     // Category Header
     Kirigami.AbstractCard {
@@ -114,61 +126,62 @@ ColumnLayout {
     }
 
     // Device Grid
-    Flow {
-        id: deviceGrid
+    Loader {
         Layout.fillWidth: true
         Layout.leftMargin: Kirigami.Units.largeSpacing * 2
-        
+
+        active: root.devicesRequested
+        asynchronous: true
         visible: root.isExpanded
-        spacing: Kirigami.Units.largeSpacing
 
-        property int calculatedHeight: 0
+        sourceComponent: Flow {
+            id: deviceGrid
 
-        Repeater {
-            model: root.categoryDevices
+            spacing: Kirigami.Units.largeSpacing
 
-            delegate: DeviceCard {
-                required property var modelData
+            property int calculatedHeight: 0
 
-                width: Math.max(280, Math.min(400, (deviceGrid.width - deviceGrid.spacing * 2) / 3))
-                height: deviceGrid.calculatedHeight
-                
-                onImplicitHeightChanged: {
-                    deviceGrid.calculatedHeight = Math.max(deviceGrid.calculatedHeight, implicitHeight);
-                }
+            Repeater {
+                model: root.categoryDevices
 
-                deviceData: modelData
-                isSelected: root.selectedDevice === modelData.id
-                selectedDevice: root.selectedDevice
-                driverCount: modelData.drivers.length
+                delegate: DeviceCard {
+                    required property string id
+                    required property var drivers
 
-                onDeviceClicked: root.deviceSelected(modelData.id)
-            }
-        }
-    }
+                    width: Math.max(280, Math.min(400, (deviceGrid.width - deviceGrid.spacing * 2) / 3))
+                    height: deviceGrid.calculatedHeight
+                    
+                    onImplicitHeightChanged: {
+                        deviceGrid.calculatedHeight = Math.max(deviceGrid.calculatedHeight, implicitHeight);
+                    }
 
-    // Driver Details Panel (shown when device is selected)
-    DriverDetailsPanel {
-        id: driverPanel
-        
-        selectedDeviceData: {
-            if (!root.categoryDevices || !root.selectedDevice) return null;
-            
-            for (let i = 0; i < root.categoryDevices.length; i++) {
-                if (root.categoryDevices[i].id === root.selectedDevice) {
-                    return root.categoryDevices[i];
+                    isSelected: root.selectedDevice === id
+                    selectedDevice: root.selectedDevice
+                    driverCount: drivers.length
+
+                    onDeviceClicked: root.deviceSelected(id)
                 }
             }
-            return null;
         }
-        
-        visible: root.isExpanded && !!selectedDeviceData?.hasDrivers
-        deviceId: root.selectedDevice
-        installingDrivers: root.installingDrivers
-        viewModel: root.viewModel
-        
+    }
+
+    // Driver Details Panel (created when a device with drivers is selected)
+    Loader {
+        Layout.fillWidth: true
+        Layout.leftMargin: Kirigami.Units.largeSpacing * 2
 
-        onInstallDriver: (deviceId, driverId) => root.installDriver(deviceId, driverId)
-        onRemoveDriver: (deviceId, driverId) => root.removeDriver(deviceId, driverId)
+        active: root.isExpanded && !!root.selectedDeviceData?.hasDrivers
+        asynchronous: true
+        visible: active
+
+        sourceComponent: DriverDetailsPanel {
+            selectedDeviceData: root.selectedDeviceData
+            deviceId: root.selectedDevice
+            installingDrivers: root.installingDrivers
+            viewModel: root.viewModel
+
+            onInstallDriver: (deviceId, driverId) => root.installDriver(deviceId, driverId)
+            onRemoveDriver: (deviceId, driverId) => root.removeDriver(deviceId, driverId)
+        }
     }
 }
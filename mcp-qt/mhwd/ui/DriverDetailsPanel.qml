@@ -19,9 +19,6 @@ Kirigami.AbstractCard {
     signal installDriver(deviceId: string, driverId: string)
     signal removeDriver(deviceId: string, driverId: string)
 
-    Layout.fillWidth: true
-    Layout.leftMargin: Kirigami.Units.largeSpacing * 2
-
     header: Kirigami.Heading {
             id: headerTitle
 
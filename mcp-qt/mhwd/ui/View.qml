@@ -59,20 +59,14 @@ QQC2.Page {
                             enabled: root.busTypeFilter !== "all"
                             
                             component RoleData: QtObject { 
-                                property var devices 
+                                property var busTypes 
                             }
                             
                             function filter(data: RoleData): bool {
-                                if (!data.devices) return false;
-                                
-                                for (let i = 0; i < data.devices.length; i++) {
-                                    const device = data.devices[i];
-
-                                    if (device && device.busType.toLowerCase() === root.busTypeFilter.toLowerCase()) {
-                                        return true;
-                                    }
-                                }
-                                return false;
+                                if (!data.busTypes) return false;
+
+                                const wanted = root.busTypeFilter.toLowerCase();
+                                return data.busTypes.some(busType => busType.toLowerCase() === wanted);
                             }
                         }
                     ]
@@ -81,8 +75,6 @@ QQC2.Page {
                 delegate: CategorySection {
                     required property string name
                     required property string icon
-                    required property int deviceCount
-                    required property int driversAvailableCount
                     required property var devices
                     required property int index
 